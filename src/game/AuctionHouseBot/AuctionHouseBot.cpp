@@ -254,16 +254,18 @@ class AuctionBotBuyer : public AuctionBotAgent
         /**
          * Places the bid to entry.
          *
+         * @param auctionHouse The auction house the entry is listed in.
          * @param auction The auction.
          * @param bidPrice The bid price.
          */
-        void        PlaceBidToEntry(AuctionEntry* auction, uint64 bidPrice);
+        void        PlaceBidToEntry(AuctionHouseObject* auctionHouse, AuctionEntry* auction, uint64 bidPrice);
         /**
          * Buys the entry.
          *
+         * @param auctionHouse The auction house the entry is listed in.
          * @param auction The auction.
          */
-        void        BuyEntry(AuctionEntry* auction);
+        void        BuyEntry(AuctionHouseObject* auctionHouse, AuctionEntry* auction);
         /**
          * Prepares the list of entry.
          *
@@ -965,16 +967,16 @@ bool AuctionBotBuyer::IsBidableEntry(uint64 bidPrice, double InGame_BuyPrice, do
     }
 }
 
-void AuctionBotBuyer::PlaceBidToEntry(AuctionEntry* auction, uint64 bidPrice)
+void AuctionBotBuyer::PlaceBidToEntry(AuctionHouseObject* auctionHouse, AuctionEntry* auction, uint64 bidPrice)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: Bid placed to entry %u, %.2fg", auction->Id, float(bidPrice) / 10000.0f);
-    auction->UpdateBid(bidPrice);
+    auctionHouse->UpdateBid(auction, bidPrice);
 }
 
-void AuctionBotBuyer::BuyEntry(AuctionEntry* auction)
+void AuctionBotBuyer::BuyEntry(AuctionHouseObject* auctionHouse, AuctionEntry* auction)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: Entry %u bought at %.2fg", auction->Id, float(auction->buyout) / 10000.0f);
-    auction->UpdateBid(auction->buyout);
+    auctionHouse->UpdateBid(auction, auction->buyout);
 }
 
 void AuctionBotBuyer::addNewAuctionBuyerBotBid(AHB_Buyer_Config& config)
@@ -1096,29 +1098,29 @@ void AuctionBotBuyer::addNewAuctionBuyerBotBid(AHB_Buyer_Config& config)
                 if (IsBidableEntry(bidPriceByItem, InGame_BuyPrice, MaxBidablePrice, minBidPrice, MaxChance / 2, config.FactionChance))
                     if (urand(0, 5) == 0)
                     {
-                        PlaceBidToEntry(auction, bidPrice);
+                        PlaceBidToEntry(auctionHouse, auction, bidPrice);
                     }
                     else
                     {
-                        BuyEntry(auction);
+                        BuyEntry(auctionHouse, auction);
                     }
                 else
                 {
-                    BuyEntry(auction);
+                    BuyEntry(auctionHouse, auction);
                 }
             }
             else
             {
                 if (IsBidableEntry(bidPriceByItem, InGame_BuyPrice, MaxBidablePrice, minBidPrice, MaxChance / 2, config.FactionChance))
                 {
-                    PlaceBidToEntry(auction, bidPrice);
+                    PlaceBidToEntry(auctionHouse, auction, bidPrice);
                 }
             }
         }
         else // buyout = 0 mean only bid are possible
             if (IsBidableEntry(bidPriceByItem, InGame_BuyPrice, MaxBidablePrice, minBidPrice, MaxChance, config.FactionChance))
             {
-                PlaceBidToEntry(auction, bidPrice);
+                PlaceBidToEntry(auctionHouse, auction, bidPrice);
             }
 
         auctionEval.LastChecked = Now;
@@ -2199,7 +2201,8 @@ void AuctionHouseBot::Rebuild(bool all)
 {
     for (uint32 i = 0; i < MAX_AUCTION_HOUSE_TYPE; ++i)
     {
-        AuctionHouseObject::AuctionEntryMapBounds bounds = sAuctionMgr.GetAuctionsMap(AuctionHouseType(i))->GetAuctionsBounds();
+        AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(AuctionHouseType(i));
+        AuctionHouseObject::AuctionEntryMapBounds bounds = auctionHouse->GetAuctionsBounds();
         for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = bounds.first; itr != bounds.second; ++itr)
         {
             AuctionEntry* entry = itr->second;
@@ -2207,7 +2210,7 @@ void AuctionHouseBot::Rebuild(bool all)
             {
                 if (all || entry->bid == 0)                                                        // expire auction now if no bid or forced
                 {
-                    entry->expireTime = sWorld.GetGameTime();
+                    auctionHouse->SetExpireTime(entry, sWorld.GetGameTime());
                 }
             }
         }
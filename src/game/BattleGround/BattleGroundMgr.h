@@ -101,6 +101,8 @@ struct GroupQueueInfo
     uint32  IsInvitedToBGInstanceGUID;                      /**< was invited to certain BG */
     uint32  ArenaTeamRating;                                // if rated match, inited to the rating of the team
     uint32  OpponentsTeamRating;                            // for rated arena matches
+    BattleGroundBracketId BracketId;                        /**< bracket of the queue the group is in */
+    uint8   QueueGroupType;                                 /**< BattleGroundQueueGroupTypes of the queue the group is in */
 };
 
 /**
@@ -254,6 +256,20 @@ class BattleGroundQueue
         */
         GroupsQueueType m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT]; /**< TODO */
 
+        /**
+         * @brief players of not yet invited groups in each queue, tells without walking the queue if a match is possible at all
+         *
+         */
+        uint32 m_WaitingPlayerCount[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
+
+        /**
+         * @brief moves a queued group to the front of another queue of its bracket
+         *
+         * @param itr position of the group in its current queue
+         * @param queueGroupType
+         */
+        void MoveQueuedGroup(GroupsQueueType::iterator itr, uint8 queueGroupType);
+
         /**
          * @brief class to select and invite groups to bg
          *
@@ -37,6 +37,7 @@
 #include "ObjectMgr.h"
 #include "ObjectGuid.h"
 #include "SpellMgr.h"
+#include "LootMgr.h"
 
 /**********************************************************************
      CommandTable : debugCommandTable
@@ -1517,4 +1518,58 @@ bool ChatHandler::HandleDebugPhaseCommand(char* args)
 
     m_session->GetPlayer()->HandleEmoteCommand(emote_id);
     return true;
-}
\ No newline at end of file
+}
+
+// Rolls a creature loot template for a number of kills and reports how often every item dropped
+bool ChatHandler::HandleDebugLootSimCommand(char* args)
+{
+    uint32 lootId;
+    if (!ExtractUInt32(&args, lootId))
+    {
+        return false;
+    }
+
+    uint32 kills;
+    if (!ExtractOptUInt32(&args, kills, 10000) || !kills)
+    {
+        return false;
+    }
+
+    kills = std::min(kills, uint32(1000000));
+
+    LootTemplate const* tab = LootTemplates_Creature.GetLootFor(lootId);
+    if (!tab)
+    {
+        PSendSysMessage("Creature loot template %u does not exist.", lootId);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    std::map<uint32, uint32> drops;                         // item id -> times dropped
+    uint32 itemCount = 0;
+    uint32 startTime = getMSTime();
+
+    for (uint32 i = 0; i < kills; ++i)
+    {
+        Loot loot(m_session ? m_session->GetPlayer() : NULL);
+        tab->Process(loot, LootTemplates_Creature, LootTemplates_Creature.IsRatesAllowed());
+
+        for (LootItemList::const_iterator itr = loot.items.begin(); itr != loot.items.end(); ++itr)
+        {
+            ++drops[itr->itemid];
+            ++itemCount;
+        }
+    }
+
+    uint32 elapsed = GetMSTimeDiffToNow(startTime);
+
+    PSendSysMessage("Creature loot template %u: %u kills rolled in %u ms, %.2f items per kill (quest items not counted).",
+                    lootId, kills, elapsed, float(itemCount) / kills);
+
+    for (std::map<uint32, uint32>::const_iterator itr = drops.begin(); itr != drops.end(); ++itr)
+    {
+        PSendSysMessage("  Item %u: %u drops (%.3f%%)", itr->first, itr->second, itr->second * 100.0f / kills);
+    }
+
+    return true;
+}
@@ -280,6 +280,16 @@ bool ChatHandler::HandleMmapStatsCommand(char* /*args*/)
     PSendSysMessage(" %u triangles (%u vertices)", triCount, triVertCount);
     PSendSysMessage(" %.2f MB of data (not including pointers)", ((float)dataSize / sizeof(unsigned char)) / 1048576);
 
+    Player* player = m_session->GetPlayer();
+    if (MMAP::PathCorridorCache* cache = manager->GetPathCorridorCache(player->GetMapId(), player->GetInstanceId()))
+    {
+        uint32 lookups = cache->GetHits() + cache->GetMisses();
+        PSendSysMessage("Path corridor cache on current map:");
+        PSendSysMessage(" %u/%u corridors cached", cache->GetSize(), cache->GetMaxSize());
+        PSendSysMessage(" %u hits, %u misses (%.1f%% hit rate)", cache->GetHits(), cache->GetMisses(),
+                        lookups ? cache->GetHits() * 100.0f / lookups : 0.0f);
+    }
+
     return true;
 }
 
@@ -35,6 +35,7 @@
 #include "ItemEnchantmentMgr.h"
 #include "CommandMgr.h"
 #include "ObjectMgr.h"
+#include "AuctionHouseMgr.h"
 
 /**********************************************************************
     CommandTable : reloadCommandTable
@@ -941,6 +942,7 @@ bool ChatHandler::HandleReloadLocalesItemCommand(char* /*args*/)
 {
     sLog.outString("Re-Loading Locales Item ... ");
     sObjectMgr.LoadItemLocales();
+    sAuctionMgr.ClearItemNameCache();
     SendGlobalSysMessage("DB table `locales_item` reloaded.", SEC_MODERATOR);
     return true;
 }
@@ -30,6 +30,12 @@
 #include "SystemConfig.h"
 #include "BattleGroundMgr.h"
 #include "UpdateTime.h"
+#include "OpcodeStats.h"
+#include "TickProfiler.h"
+#include "LineOfSightCache.h"
+#include "LFGMgr.h"
+#include "MapManager.h"
+#include "Opcodes.h"
 #include "MapPersistentStateMgr.h"
 #include "ObjectAccessor.h"
 #include "revision_data.h"
@@ -293,6 +299,216 @@ bool ChatHandler::HandleServerSetMotdCommand(char* args)
     return true;
 }
 
+bool ChatHandler::HandleServerOpcodeStatsCommand(char* args)
+{
+    if (ExtractLiteralArg(&args, "reset"))
+    {
+        sOpcodeStats.Reset();
+        SendSysMessage("Opcode stats reset.");
+        return true;
+    }
+
+    uint32 count;
+    if (!ExtractOptUInt32(&args, count, 10))
+    {
+        return false;
+    }
+
+    if (!sWorld.getConfig(CONFIG_BOOL_OPCODE_STATS))
+    {
+        SendSysMessage("Opcode stats are disabled, set OpcodeStats.Enable in the config.");
+    }
+
+    OpcodeStatList stats;
+    sOpcodeStats.GetStats(stats, OPCODE_STATS_SORT_TOTAL_TIME, count);
+
+    PSendSysMessage("Top %u opcodes by handler time, collected for %s:", count, secsToTimeString(sOpcodeStats.GetCollectTime(), TimeFormat::ShortText).c_str());
+    for (OpcodeStatList::const_iterator itr = stats.begin(); itr != stats.end(); ++itr)
+    {
+        OpcodeStatEntry const& entry = itr->second;
+        PSendSysMessage("%s (0x%.4X): calls " UI64FMTD ", total " UI64FMTD " ms, avg " UI64FMTD " us, max " UI64FMTD " us, in " UI64FMTD " B, sent " UI64FMTD " / " UI64FMTD " B",
+                        LookupOpcodeName(itr->first), itr->first, entry.calls, entry.totalTime / IN_MILLISECONDS,
+                        entry.calls ? entry.totalTime / entry.calls : 0, entry.maxTime, entry.bytesIn, entry.sent, entry.bytesOut);
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandleServerTickStatsCommand(char* args)
+{
+    uint32 mapId;
+    if (!ExtractOptUInt32(&args, mapId, uint32(-1)))
+    {
+        return false;
+    }
+
+    TickProfile const* worldProfile = sWorld.GetTickProfile();
+    if (!worldProfile)
+    {
+        SendSysMessage("Tick profiler is disabled, set TickProfiler.Enable in the config.");
+        return true;
+    }
+
+    TickPhaseStats stats;
+
+    // phases of every instance of the map
+    if (mapId != uint32(-1))
+    {
+        bool found = false;
+        for (MapManager::MapMapType::const_iterator itr = sMapMgr.Maps().begin(); itr != sMapMgr.Maps().end(); ++itr)
+        {
+            Map const* map = itr->second;
+            if (map->GetId() != mapId || !map->GetTickProfile())
+            {
+                continue;
+            }
+
+            found = true;
+            PSendSysMessage("Map %u (%s) instance %u, players: %u", map->GetId(), map->GetMapName(), map->GetInstanceId(), map->GetPlayersCountExceptGMs());
+            for (uint32 phase = 0; phase < MAX_MAP_TICK_PHASES; ++phase)
+            {
+                map->GetTickProfile()->GetStats(phase, stats);
+                PSendSysMessage("  %s: p50 %u us, p99 %u us, max %u us", GetMapTickPhaseName(phase), stats.p50, stats.p99, stats.max);
+            }
+        }
+
+        if (!found)
+        {
+            PSendSysMessage("No profiled instance of map %u.", mapId);
+        }
+
+        return true;
+    }
+
+    worldProfile->GetStats(WORLD_TICK_TOTAL, stats);
+    PSendSysMessage("World update over the last %u ticks:", stats.samples);
+    for (uint32 phase = 0; phase < MAX_WORLD_TICK_PHASES; ++phase)
+    {
+        worldProfile->GetStats(phase, stats);
+        PSendSysMessage("  %s: p50 %u us, p99 %u us, max %u us", GetWorldTickPhaseName(phase), stats.p50, stats.p99, stats.max);
+    }
+
+    // slowest maps by their p99 update time
+    std::vector<std::pair<uint32, Map const*> > maps;
+    for (MapManager::MapMapType::const_iterator itr = sMapMgr.Maps().begin(); itr != sMapMgr.Maps().end(); ++itr)
+    {
+        if (TickProfile const* mapProfile = itr->second->GetTickProfile())
+        {
+            mapProfile->GetStats(MAP_TICK_TOTAL, stats);
+            maps.push_back(std::make_pair(stats.p99, itr->second));
+        }
+    }
+
+    std::sort(maps.begin(), maps.end(), [](std::pair<uint32, Map const*> const& a, std::pair<uint32, Map const*> const& b)
+    {
+        return a.first > b.first;
+    });
+
+    if (maps.size() > 5)
+    {
+        maps.resize(5);
+    }
+
+    SendSysMessage("Slowest maps:");
+    for (std::vector<std::pair<uint32, Map const*> >::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+    {
+        Map const* map = itr->second;
+        map->GetTickProfile()->GetStats(MAP_TICK_TOTAL, stats);
+        PSendSysMessage("  map %u (%s) instance %u: p50 %u us, p99 %u us, max %u us", map->GetId(), map->GetMapName(), map->GetInstanceId(), stats.p50, stats.p99, stats.max);
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandleServerLosStatsCommand(char* /*args*/)
+{
+    uint32 hits = 0;
+    uint32 misses = 0;
+    std::vector<Map const*> maps;
+    for (MapManager::MapMapType::const_iterator itr = sMapMgr.Maps().begin(); itr != sMapMgr.Maps().end(); ++itr)
+    {
+        if (LineOfSightCache const* cache = itr->second->GetLineOfSightCache())
+        {
+            hits += cache->GetHits();
+            misses += cache->GetMisses();
+            maps.push_back(itr->second);
+        }
+    }
+
+    if (maps.empty())
+    {
+        SendSysMessage("Line of sight cache is disabled, set vmap.losCacheSize in the config.");
+        return true;
+    }
+
+    PSendSysMessage("Line of sight cache of %u map instances: %u hits, %u misses (%.1f%% hit rate)", uint32(maps.size()), hits, misses,
+                    hits + misses ? hits * 100.0f / (hits + misses) : 0.0f);
+
+    // maps doing the most checks
+    std::sort(maps.begin(), maps.end(), [](Map const* a, Map const* b)
+    {
+        LineOfSightCache const* cacheA = a->GetLineOfSightCache();
+        LineOfSightCache const* cacheB = b->GetLineOfSightCache();
+        return cacheA->GetHits() + cacheA->GetMisses() > cacheB->GetHits() + cacheB->GetMisses();
+    });
+
+    if (maps.size() > 5)
+    {
+        maps.resize(5);
+    }
+
+    for (std::vector<Map const*>::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+    {
+        Map const* map = *itr;
+        LineOfSightCache const* cache = map->GetLineOfSightCache();
+        uint32 lookups = cache->GetHits() + cache->GetMisses();
+        PSendSysMessage("  map %u (%s) instance %u: %u hits, %u misses (%.1f%% hit rate), %u invalidations", map->GetId(), map->GetMapName(), map->GetInstanceId(),
+                        cache->GetHits(), cache->GetMisses(), lookups ? cache->GetHits() * 100.0f / lookups : 0.0f, cache->GetInvalidations());
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandleServerBufferStatsCommand(char* /*args*/)
+{
+    uint64 heap = ByteBufferPool::GetHeapAllocations();
+    uint64 pooled = ByteBufferPool::GetPooledAllocations();
+
+    PSendSysMessage("Packet buffer allocations since startup: " UI64FMTD " from free lists, " UI64FMTD " from the heap (%.1f%% reused)", pooled, heap,
+                    heap + pooled ? pooled * 100.0f / (heap + pooled) : 0.0f);
+    return true;
+}
+
+bool ChatHandler::HandleServerLfgStatsCommand(char* /*args*/)
+{
+    typedef std::vector<std::pair<std::pair<uint32, uint32>, LFGQueueBucket const*> > LfgQueueStats;
+
+    LfgQueueStats stats;
+    sLFGMgr.GetQueueStats(stats);
+
+    PSendSysMessage("Dungeon finder queue: %u players or groups in %u dungeon queues", sLFGMgr.GetQueuedCount(), uint32(stats.size()));
+
+    // deepest queues first
+    std::sort(stats.begin(), stats.end(), [](LfgQueueStats::value_type const& a, LfgQueueStats::value_type const& b)
+    {
+        return a.second->entries.size() > b.second->entries.size();
+    });
+
+    if (stats.size() > 10)
+    {
+        stats.resize(10);
+    }
+
+    for (LfgQueueStats::const_iterator itr = stats.begin(); itr != stats.end(); ++itr)
+    {
+        LFGQueueBucket const* bucket = itr->second;
+        PSendSysMessage("  dungeon %u (%s): %u queued, %u players, %u can tank, %u can heal, %u can dps", itr->first.first, itr->first.second == ALLIANCE ? "alliance" : (itr->first.second == HORDE ? "horde" : "no team"),
+                        uint32(bucket->entries.size()), bucket->players, bucket->tanks, bucket->healers, bucket->dps);
+    }
+
+    return true;
+}
+
 bool ChatHandler::HandleServerPLimitCommand(char* args)
 {
     if (*args)
@@ -36,6 +36,11 @@ using Movement::PointsArray;
 
 class Unit;
 
+namespace MMAP
+{
+    class PathCorridorCache;
+}
+
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
 // I think we can safely cut those down even more
@@ -101,6 +106,7 @@ class PathFinder
         const Unit* const       m_sourceUnit;       // the unit that is moving
         const dtNavMesh*        m_navMesh;          // the nav mesh
         const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path
+        MMAP::PathCorridorCache* m_corridorCache;   // recent corridors of this map instance, NULL if disabled
 
         dtQueryFilter m_filter;                     // use single filter for all movements, update it when needed
 
@@ -61,6 +61,26 @@ AuctionHouseMgr::~AuctionHouseMgr()
     }
 }
 
+AuctionItemName const& AuctionHouseMgr::GetItemName(ItemPrototype const* proto, int32 loc_idx)
+{
+    uint64 key = (uint64(loc_idx + 1) << 32) | proto->ItemId;
+
+    ItemNameMap::const_iterator itr = mItemNames.find(key);
+    if (itr != mItemNames.end())
+    {
+        return itr->second;
+    }
+
+    std::string name = proto->Name1;
+    sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
+
+    AuctionItemName& itemName = mItemNames[key];
+    Utf8toWStr(name, itemName.name);
+    itemName.lowerName = itemName.name;
+    wstrToLower(itemName.lowerName);
+    return itemName;
+}
+
 AuctionHouseObject* AuctionHouseMgr::GetAuctionsMap(AuctionHouseEntry const* house)
 {
     if (sWorld.getConfig(CONFIG_BOOL_ALLOW_TWO_SIDE_INTERACTION_AUCTION))
@@ -621,85 +641,387 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(Unit* unit)
 void AuctionHouseObject::Update()
 {
     time_t curTime = sWorld.GetGameTime();
-    ///- Handle expired auctions
-    for (AuctionEntryMap::iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end();)
+    ///- Handle expired auctions, only the ones at the front of the expiry queue are due
+    while (!m_expiryQueue.empty() && curTime > m_expiryQueue.top().first)
     {
-        if (itr->second->moneyDeliveryTime)                 // pending auction
+        AuctionExpiryEntry next = m_expiryQueue.top();
+        m_expiryQueue.pop();
+
+        AuctionEntryMap::iterator itr = AuctionsMap.find(next.second);
+        if (itr == AuctionsMap.end())                       // already removed
         {
-            if (curTime > itr->second->moneyDeliveryTime)
-            {
-                sAuctionMgr.SendAuctionSuccessfulMail(itr->second);
+            continue;
+        }
 
-                itr->second->DeleteFromDB();
-                MANGOS_ASSERT(!itr->second->itemGuidLow);   // already removed or send in mail at won
-                delete itr->second;
-                AuctionsMap.erase(itr++);
+        AuctionEntry* auction = itr->second;
+        if (auction->moneyDeliveryTime)                     // pending auction
+        {
+            if (auction->moneyDeliveryTime != next.first)   // queued for its expire time before it was won
+            {
                 continue;
             }
+
+            sAuctionMgr.SendAuctionSuccessfulMail(auction);
+
+            auction->DeleteFromDB();
+            MANGOS_ASSERT(!auction->itemGuidLow);           // already removed or send in mail at won
+            RemoveFromIndexes(auction);
+            delete auction;
+            AuctionsMap.erase(itr);
         }
         else                                                // active auction
         {
-            if (curTime > itr->second->expireTime)
+            if (auction->expireTime != next.first)
             {
-                ///- perform the transaction if there was bidder
-                if (itr->second->bid)
-                {
-                    itr->second->AuctionBidWinning();
-                }
-                ///- cancel the auction if there was no bidder and clear the auction
-                else
+                // expire time moved to later without going through SetExpireTime, wait for it
+                // an earlier one is already overdue and handled right now
+                if (auction->expireTime > next.first)
                 {
-                    sAuctionMgr.SendAuctionExpiredMail(itr->second);
-
-                    itr->second->DeleteFromDB();
-                    delete itr->second;
-                    AuctionsMap.erase(itr++);
+                    m_expiryQueue.push(AuctionExpiryEntry(auction->expireTime, auction->Id));
                     continue;
                 }
             }
+
+            ///- perform the transaction if there was bidder
+            if (auction->bid)
+            {
+                auction->AuctionBidWinning();
+                ScheduleExpiry(auction);
+            }
+            ///- cancel the auction if there was no bidder and clear the auction
+            else
+            {
+                sAuctionMgr.SendAuctionExpiredMail(auction);
+
+                auction->DeleteFromDB();
+                RemoveFromIndexes(auction);
+                delete auction;
+                AuctionsMap.erase(itr);
+            }
+        }
+    }
+
+    RemoveExpiredSearchResults();
+}
+
+void AuctionHouseObject::AddAuction(AuctionEntry* ah)
+{
+    MANGOS_ASSERT(ah);
+    AuctionsMap[ah->Id] = ah;
+    AddToClassIndex(ah);
+    AddToPlayerIndex(m_ownerIndex, ah->owner, ah);
+    AddToPlayerIndex(m_bidderIndex, ah->bidder, ah);
+    ScheduleExpiry(ah);
+}
+
+bool AuctionHouseObject::RemoveAuction(uint32 id)
+{
+    AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+    if (itr == AuctionsMap.end())
+    {
+        return false;
+    }
+
+    RemoveFromIndexes(itr->second);
+    AuctionsMap.erase(itr);
+    return true;
+}
+
+bool AuctionHouseObject::UpdateBid(AuctionEntry* auction, uint64 newbid, Player* newbidder /*=NULL*/)
+{
+    uint32 oldBidder = auction->bidder;
+    bool isBid = auction->UpdateBid(newbid, newbidder);
+
+    if (auction->bidder != oldBidder)
+    {
+        RemoveFromPlayerIndex(m_bidderIndex, oldBidder, auction);
+        AddToPlayerIndex(m_bidderIndex, auction->bidder, auction);
+    }
+
+    if (!isBid)                                             // buyout, money is delivered at moneyDeliveryTime now
+    {
+        ScheduleExpiry(auction);
+    }
+
+    return isBid;
+}
+
+void AuctionHouseObject::AddToPlayerIndex(AuctionPlayerIndex& index, uint32 guidLow, AuctionEntry* auction)
+{
+    if (guidLow)
+    {
+        index[guidLow][auction->Id] = auction;
+    }
+}
+
+void AuctionHouseObject::RemoveFromPlayerIndex(AuctionPlayerIndex& index, uint32 guidLow, AuctionEntry* auction)
+{
+    AuctionPlayerIndex::iterator itr = index.find(guidLow);
+    if (itr == index.end())
+    {
+        return;
+    }
+
+    itr->second.erase(auction->Id);
+    if (itr->second.empty())
+    {
+        index.erase(itr);
+    }
+}
+
+void AuctionHouseObject::RemoveFromIndexes(AuctionEntry* auction)
+{
+    RemoveFromClassIndex(auction);
+    RemoveFromPlayerIndex(m_ownerIndex, auction->owner, auction);
+    RemoveFromPlayerIndex(m_bidderIndex, auction->bidder, auction);
+}
+
+void AuctionHouseObject::SetExpireTime(AuctionEntry* auction, time_t expireTime)
+{
+    auction->expireTime = expireTime;
+    ScheduleExpiry(auction);
+}
+
+void AuctionHouseObject::ScheduleExpiry(AuctionEntry* auction)
+{
+    time_t dueTime = auction->moneyDeliveryTime ? auction->moneyDeliveryTime : auction->expireTime;
+    m_expiryQueue.push(AuctionExpiryEntry(dueTime, auction->Id));
+}
+
+static uint32 GetAuctionClassKey(AuctionEntry const* auction)
+{
+    ItemPrototype const* proto = ObjectMgr::GetItemPrototype(auction->itemTemplate);
+    return proto ? (proto->Class << 16) | proto->SubClass : 0xFFFFFFFF;
+}
+
+void AuctionHouseObject::AddToClassIndex(AuctionEntry* auction)
+{
+    m_classIndex[GetAuctionClassKey(auction)][auction->Id] = auction;
+}
+
+void AuctionHouseObject::RemoveFromClassIndex(AuctionEntry* auction)
+{
+    AuctionClassIndex::iterator itr = m_classIndex.find(GetAuctionClassKey(auction));
+    if (itr == m_classIndex.end())
+    {
+        return;
+    }
+
+    itr->second.erase(auction->Id);
+    if (itr->second.empty())
+    {
+        m_classIndex.erase(itr);
+    }
+}
+
+void AuctionHouseObject::RemoveExpiredSearchResults()
+{
+    uint32 cacheTime = sWorld.getConfig(CONFIG_UINT32_AUCTION_SEARCH_CACHE_TIME);
+    uint32 curTime = getMSTime();
+
+    for (AuctionSearchCache::iterator itr = m_searchCache.begin(); itr != m_searchCache.end();)
+    {
+        if (getMSTimeDiff(itr->second.createTime, curTime) >= cacheTime)
+        {
+            m_searchCache.erase(itr++);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
+
+AuctionIdList const& AuctionHouseObject::SearchAuctions(AuctionSearchQuery const& query, Player* viewPlayer)
+{
+    uint32 cacheTime = sWorld.getConfig(CONFIG_UINT32_AUCTION_SEARCH_CACHE_TIME);
+    uint32 curTime = getMSTime();
+
+    AuctionSearchResult* result = &m_uncachedResult;
+    if (cacheTime)
+    {
+        AuctionSearchCache::iterator itr = m_searchCache.find(query);
+        if (itr != m_searchCache.end())
+        {
+            if (getMSTimeDiff(itr->second.createTime, curTime) < cacheTime)
+            {
+                return itr->second.auctions;
+            }
+        }
+        else
+        {
+            // results can hold a whole auction house, so do not keep expired ones around
+            RemoveExpiredSearchResults();
+            if (m_searchCache.size() >= MAX_AUCTION_SEARCH_CACHE_SIZE)
+            {
+                m_searchCache.clear();
+            }
+        }
+
+        result = &m_searchCache[query];
+    }
+
+    // only look at the item classes the query can match
+    AuctionClassIndex::const_iterator begin = m_classIndex.begin();
+    AuctionClassIndex::const_iterator end = m_classIndex.end();
+    if (query.itemClass != 0xFFFFFFFF)
+    {
+        if (query.itemSubClass != 0xFFFFFFFF)
+        {
+            begin = m_classIndex.lower_bound((query.itemClass << 16) | query.itemSubClass);
+            end = m_classIndex.upper_bound((query.itemClass << 16) | query.itemSubClass);
+        }
+        else
+        {
+            begin = m_classIndex.lower_bound(query.itemClass << 16);
+            end = m_classIndex.lower_bound((query.itemClass + 1) << 16);
+        }
+    }
+
+    std::vector<AuctionEntry*> auctions;
+    for (AuctionClassIndex::const_iterator classItr = begin; classItr != end; ++classItr)
+    {
+        for (AuctionEntryMap::const_iterator itr = classItr->second.begin(); itr != classItr->second.end(); ++itr)
+        {
+            AuctionEntry* Aentry = itr->second;
+            if (Aentry->moneyDeliveryTime)
+            {
+                continue;
+            }
+
+            ItemPrototype const* proto = ObjectMgr::GetItemPrototype(Aentry->itemTemplate);
+            if (!proto)
+            {
+                continue;
+            }
+
+            if (query.inventoryType != 0xFFFFFFFF && proto->InventoryType != query.inventoryType)
+            {
+                continue;
+            }
+
+            if (query.quality != 0xFFFFFFFF && proto->Quality < query.quality)
+            {
+                continue;
+            }
+
+            if (query.levelmin != 0x00 && (proto->RequiredLevel < query.levelmin || (query.levelmax != 0x00 && proto->RequiredLevel > query.levelmax)))
+            {
+                continue;
+            }
+
+            if (!query.name.empty() && sAuctionMgr.GetItemName(proto, query.locale).lowerName.find(query.name) == std::wstring::npos)
+            {
+                continue;
+            }
+
+            auctions.push_back(Aentry);
         }
+    }
+
+    AuctionSorter sorter(const_cast<uint8*>(query.sort), viewPlayer);
+    std::sort(auctions.begin(), auctions.end(), sorter);
+
+    result->createTime = curTime;
+    result->auctions.clear();
+    result->auctions.reserve(auctions.size());
+    for (std::vector<AuctionEntry*>::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
+    {
+        result->auctions.push_back((*itr)->Id);
+    }
+
+    return result->auctions;
+}
+
+bool AuctionSearchQuery::operator<(AuctionSearchQuery const& other) const
+{
+    if (locale != other.locale)
+    {
+        return locale < other.locale;
+    }
+
+    if (levelmin != other.levelmin)
+    {
+        return levelmin < other.levelmin;
+    }
+
+    if (levelmax != other.levelmax)
+    {
+        return levelmax < other.levelmax;
+    }
+
+    if (inventoryType != other.inventoryType)
+    {
+        return inventoryType < other.inventoryType;
+    }
+
+    if (itemClass != other.itemClass)
+    {
+        return itemClass < other.itemClass;
+    }
+
+    if (itemSubClass != other.itemSubClass)
+    {
+        return itemSubClass < other.itemSubClass;
+    }
+
+    if (quality != other.quality)
+    {
+        return quality < other.quality;
+    }
 
-        ++itr;
+    int cmp = memcmp(sort, other.sort, sizeof(sort));
+    if (cmp != 0)
+    {
+        return cmp < 0;
     }
+
+    return name < other.name;
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
 {
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionPlayerIndex::const_iterator bids = m_bidderIndex.find(player->GetGUIDLow());
+    if (bids == m_bidderIndex.end())
+    {
+        return;
+    }
+
+    for (AuctionEntryMap::const_iterator itr = bids->second.begin(); itr != bids->second.end(); ++itr)
     {
         AuctionEntry* Aentry = itr->second;
         if (Aentry->moneyDeliveryTime)                      // skip pending sell auctions
         {
             continue;
         }
-        if (Aentry->bidder == player->GetGUIDLow())
+        if (Aentry->BuildAuctionInfo(data))
         {
-            if (itr->second->BuildAuctionInfo(data))
-            {
-                ++count;
-            }
-            ++totalcount;
+            ++count;
         }
+        ++totalcount;
     }
 }
 
 void AuctionHouseObject::BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
 {
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionPlayerIndex::const_iterator owned = m_ownerIndex.find(player->GetGUIDLow());
+    if (owned == m_ownerIndex.end())
+    {
+        return;
+    }
+
+    for (AuctionEntryMap::const_iterator itr = owned->second.begin(); itr != owned->second.end(); ++itr)
     {
         AuctionEntry* Aentry = itr->second;
         if (Aentry->moneyDeliveryTime)                      // skip pending sell auctions
         {
             continue;
         }
-        if (Aentry->owner == player->GetGUIDLow())
+        if (Aentry->BuildAuctionInfo(data))
         {
-            if (Aentry->BuildAuctionInfo(data))
-            {
-                ++count;
-            }
-            ++totalcount;
+            ++count;
         }
+        ++totalcount;
     }
 }
 
@@ -798,16 +1120,7 @@ int AuctionEntry::CompareAuctionEntry(uint32 column, const AuctionEntry* auc, Pl
 
             int32 loc_idx = viewPlayer->GetSession()->GetSessionDbLocaleIndex();
 
-            std::string name1 = itemProto1->Name1;
-            sObjectMgr.GetItemLocaleStrings(itemProto1->ItemId, loc_idx, &name1);
-
-            std::string name2 = itemProto2->Name1;
-            sObjectMgr.GetItemLocaleStrings(itemProto2->ItemId, loc_idx, &name2);
-
-            std::wstring wname1, wname2;
-            Utf8toWStr(name1, wname1);
-            Utf8toWStr(name2, wname2);
-            return wname1.compare(wname2);
+            return sAuctionMgr.GetItemName(itemProto1, loc_idx).name.compare(sAuctionMgr.GetItemName(itemProto2, loc_idx).name);
         }
         case 6:                                             // minbidbuyout = 6
         {
@@ -913,15 +1226,14 @@ bool AuctionSorter::operator()(const AuctionEntry* auc1, const AuctionEntry* auc
     return false;                                           // "equal" by all sorts
 }
 
-void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
-        uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull)
+void WorldSession::BuildListAuctionItems(AuctionHouseObject const* auctionHouse, AuctionIdList const& auctions, WorldPacket& data, uint32 listfrom,
+        uint32 usable, uint32& count, uint32& totalcount, bool isFull)
 {
-    int loc_idx = _player->GetSession()->GetSessionDbLocaleIndex();
-
-    for (std::vector<AuctionEntry*>::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
+    for (AuctionIdList::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
     {
-        AuctionEntry* Aentry = *itr;
-        if (Aentry->moneyDeliveryTime)
+        // the result can be cached, so the auction may be gone or sold since
+        AuctionEntry* Aentry = auctionHouse->GetAuction(*itr);
+        if (!Aentry || Aentry->moneyDeliveryTime)
         {
             continue;
         }
@@ -938,33 +1250,6 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
         }
         else
         {
-            ItemPrototype const* proto = item->GetProto();
-
-            if (itemClass != 0xffffffff && proto->Class != itemClass)
-            {
-                continue;
-            }
-
-            if (itemSubClass != 0xffffffff && proto->SubClass != itemSubClass)
-            {
-                continue;
-            }
-
-            if (inventoryType != 0xffffffff && proto->InventoryType != inventoryType)
-            {
-                continue;
-            }
-
-            if (quality != 0xffffffff && proto->Quality < quality)
-            {
-                continue;
-            }
-
-            if (levelmin != 0x00 && (proto->RequiredLevel < levelmin || (levelmax != 0x00 && proto->RequiredLevel > levelmax)))
-            {
-                continue;
-            }
-
             if (usable != 0x00)
             {
                 if (_player->CanUseItem(item) != EQUIP_ERR_OK)
@@ -972,6 +1257,7 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
                     continue;
                 }
 
+                ItemPrototype const* proto = item->GetProto();
                 if (proto->Class == ITEM_CLASS_RECIPE)
                 {
                     if (SpellEntry const* spell = sSpellStore.LookupEntry(proto->Spells[0].SpellId))
@@ -990,14 +1276,6 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
                 }
             }
 
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
-            {
-                continue;
-            }
-
             if (count < 50 && totalcount >= listfrom)
             {
                 ++count;
@@ -1011,31 +1289,34 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
 
 void AuctionHouseObject::BuildListPendingSales(WorldPacket& data, Player* player, uint32& count)
 {
-    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    AuctionPlayerIndex::const_iterator owned = m_ownerIndex.find(player->GetGUIDLow());
+    if (owned == m_ownerIndex.end())
+    {
+        return;
+    }
+
+    for (AuctionEntryMap::const_iterator itr = owned->second.begin(); itr != owned->second.end(); ++itr)
     {
         AuctionEntry* Aentry = itr->second;
         if (!Aentry->moneyDeliveryTime)                     // skip not pending auctions
         {
             continue;
         }
-        if (Aentry->owner == player->GetGUIDLow())
-        {
-            std::ostringstream str1;
-            str1 << Aentry->itemTemplate << ":" << Aentry->itemRandomPropertyId << ":" << AUCTION_SUCCESSFUL << ":" << Aentry->Id << ":" << Aentry->itemCount;
-
-            std::ostringstream str2;
-            str2.width(16);
-            str2 << std::right << std::hex << Aentry->bidder << std::dec << ":";
-            str2 << Aentry->bid << ":" << Aentry->buyout << ":" << Aentry->deposit << ":" << Aentry->GetAuctionCut();
-
-            data << str1.str();                             // string "%d:%d:%d:%d:%d" -> itemId, ItemRandomPropertyId, 2, auctionId, unk1 (stack size?, unused)
-            data << str2.str();                             // string "%16I64X:%d:%d:%d:%d" -> bidderGuid, bid, buyout, deposit, auctionCut
-            data << uint64(97250);                          // unk1
-            data << uint32(68);                             // unk2
-            float timeLeft = float(Aentry->moneyDeliveryTime - time(NULL)) / float(DAY);
-            data << float(timeLeft);                        // time left
-            ++count;
-        }
+        std::ostringstream str1;
+        str1 << Aentry->itemTemplate << ":" << Aentry->itemRandomPropertyId << ":" << AUCTION_SUCCESSFUL << ":" << Aentry->Id << ":" << Aentry->itemCount;
+
+        std::ostringstream str2;
+        str2.width(16);
+        str2 << std::right << std::hex << Aentry->bidder << std::dec << ":";
+        str2 << Aentry->bid << ":" << Aentry->buyout << ":" << Aentry->deposit << ":" << Aentry->GetAuctionCut();
+
+        data << str1.str();                                 // string "%d:%d:%d:%d:%d" -> itemId, ItemRandomPropertyId, 2, auctionId, unk1 (stack size?, unused)
+        data << str2.str();                                 // string "%16I64X:%d:%d:%d:%d" -> bidderGuid, bid, buyout, deposit, auctionCut
+        data << uint64(97250);                              // unk1
+        data << uint32(68);                                 // unk2
+        float timeLeft = float(Aentry->moneyDeliveryTime - time(NULL)) / float(DAY);
+        data << float(timeLeft);                            // time left
+        ++count;
     }
 }
 
@@ -42,6 +42,8 @@
 #include "DBCStructure.h"
 #include "World.h"
 
+#include <queue>
+
 /** \addtogroup auctionhouse
  * @{
  * \file
@@ -51,10 +53,12 @@ class Item;
 class Player;
 class Unit;
 class WorldPacket;
+struct ItemPrototype;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_SORT 12
 #define AUCTION_SORT_REVERSED 0x10
+#define MAX_AUCTION_SEARCH_CACHE_SIZE 128
 
 /**
  * Documentation for this taken directly from comments in source
@@ -114,6 +118,43 @@ struct AuctionEntry
     bool UpdateBid(uint64 newbid, Player* newbidder = NULL);// true if normal bid, false if buyout, bidder==NULL for generated bid
 };
 
+/**
+ * Filter and sort order of an auction house browse request. The usable filter is left out,
+ * it depends on the searching player and is checked while building the result page.
+ */
+struct AuctionSearchQuery
+{
+    std::wstring name;                                      ///< lower case, empty for any
+    int32 locale;                                           ///< db locale index the names are matched in
+    uint32 levelmin;
+    uint32 levelmax;
+    uint32 inventoryType;
+    uint32 itemClass;
+    uint32 itemSubClass;
+    uint32 quality;
+    uint8 sort[MAX_AUCTION_SORT];
+
+    bool operator<(AuctionSearchQuery const& other) const;
+};
+
+typedef std::vector<uint32> AuctionIdList;
+
+/// Sorted ids of the auctions matching a query, reused while the client pages through them
+struct AuctionSearchResult
+{
+    AuctionSearchResult() : createTime(0) {}
+
+    uint32 createTime;                                      ///< getMSTime() when the result was built
+    AuctionIdList auctions;
+};
+
+/// Item name as used by the auction house search, converted once per item and locale
+struct AuctionItemName
+{
+    std::wstring name;                                      ///< for sorting by name
+    std::wstring lowerName;                                 ///< for matching the searched name
+};
+
 // this class is used as auctionhouse instance
 class AuctionHouseObject
 {
@@ -135,11 +176,7 @@ class AuctionHouseObject
         AuctionEntryMap const& GetAuctions() const { return AuctionsMap; }
         AuctionEntryMapBounds GetAuctionsBounds() const {return AuctionEntryMapBounds(AuctionsMap.begin(), AuctionsMap.end()); }
 
-        void AddAuction(AuctionEntry* ah)
-        {
-            MANGOS_ASSERT(ah);
-            AuctionsMap[ah->Id] = ah;
-        }
+        void AddAuction(AuctionEntry* ah);
 
         AuctionEntry* GetAuction(uint32 id) const
         {
@@ -147,20 +184,48 @@ class AuctionHouseObject
             return itr != AuctionsMap.end() ? itr->second : NULL;
         }
 
-        bool RemoveAuction(uint32 id)
-        {
-            return AuctionsMap.erase(id);
-        }
+        bool RemoveAuction(uint32 id);
+
+        /// Bid through the house so the bidder index and expiry queue follow the auction, see AuctionEntry::UpdateBid
+        bool UpdateBid(AuctionEntry* auction, uint64 newbid, Player* newbidder = NULL);
 
         void Update();
 
+        /// Sorted ids of the active auctions matching the query, cached for AuctionHouse.SearchCacheTime
+        AuctionIdList const& SearchAuctions(AuctionSearchQuery const& query, Player* viewPlayer);
+
         void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
         void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
         void BuildListPendingSales(WorldPacket& data, Player* player, uint32& count);
 
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint64 bid, uint64 buyout = 0, uint64 deposit = 0, Player* pl = NULL);
+        // changes of expireTime of an auction in the house must go through here, the expiry queue has to know them
+        void SetExpireTime(AuctionEntry* auction, time_t expireTime);
     private:
+        // auctions by item class << 16 | item subclass, narrows the auctions a search has to look at
+        typedef std::map<uint32, AuctionEntryMap> AuctionClassIndex;
+        typedef std::map<AuctionSearchQuery, AuctionSearchResult> AuctionSearchCache;
+        // auctions by owner or bidder guid low, auctions of the AH bot (guid 0) are not indexed
+        typedef std::unordered_map<uint32, AuctionEntryMap> AuctionPlayerIndex;
+        // (time the auction has to be handled, auction id), entries are checked against the auction when popped
+        typedef std::pair<time_t, uint32> AuctionExpiryEntry;
+        typedef std::priority_queue<AuctionExpiryEntry, std::vector<AuctionExpiryEntry>, std::greater<AuctionExpiryEntry> > AuctionExpiryQueue;
+
+        void AddToClassIndex(AuctionEntry* auction);
+        void RemoveFromClassIndex(AuctionEntry* auction);
+        static void AddToPlayerIndex(AuctionPlayerIndex& index, uint32 guidLow, AuctionEntry* auction);
+        static void RemoveFromPlayerIndex(AuctionPlayerIndex& index, uint32 guidLow, AuctionEntry* auction);
+        void RemoveFromIndexes(AuctionEntry* auction);
+        void ScheduleExpiry(AuctionEntry* auction);
+        void RemoveExpiredSearchResults();
+
         AuctionEntryMap AuctionsMap;
+        AuctionClassIndex m_classIndex;
+        AuctionPlayerIndex m_ownerIndex;
+        AuctionPlayerIndex m_bidderIndex;
+        AuctionExpiryQueue m_expiryQueue;
+        AuctionSearchCache m_searchCache;
+        AuctionSearchResult m_uncachedResult;               // used when the search cache is disabled
 };
 
 class AuctionSorter
@@ -219,6 +284,10 @@ class AuctionHouseMgr
         static uint32 GetAuctionHouseTeam(AuctionHouseEntry const* house);
         static AuctionHouseEntry const* GetAuctionHouseEntry(Unit* unit);
 
+        // item names used for searching and sorting, must be cleared when the item locales are reloaded
+        AuctionItemName const& GetItemName(ItemPrototype const* proto, int32 loc_idx);
+        void ClearItemNameCache() { mItemNames.clear(); }
+
     public:
         // load first auction items, because of check if item exists, when loading
         void LoadAuctionItems();
@@ -230,9 +299,12 @@ class AuctionHouseMgr
         void Update();
 
     private:
+        typedef std::unordered_map<uint64, AuctionItemName> ItemNameMap;
+
         AuctionHouseObject  mAuctions[MAX_AUCTION_HOUSE_TYPE];
 
         ItemMap             mAitems;
+        ItemNameMap         mItemNames;                     // by locale index + 1 << 32 | item entry
 };
 
 /// Convenience define to access the singleton object for the Auction House Manager
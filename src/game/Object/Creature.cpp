@@ -1769,6 +1769,11 @@ bool Creature::LoadFromDB(uint32 guidlow, Map* map)
         return false;
     }
 
+    return LoadFromDB(guidlow, data, map);
+}
+
+bool Creature::LoadFromDB(uint32 guidlow, CreatureData const* data, Map* map)
+{
     CreatureInfo const* cinfo = ObjectMgr::GetCreatureTemplate(data->id);
     if (!cinfo)
     {
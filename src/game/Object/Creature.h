@@ -682,6 +682,7 @@ class Creature : public Unit
         void SetDeathState(DeathState s) override;          // overwrite virtual Unit::SetDeathState
 
         bool LoadFromDB(uint32 guid, Map* map);
+        bool LoadFromDB(uint32 guid, CreatureData const* data, Map* map);   // data already looked up, used by grid loading
         void SaveToDB();
         // overwrited in Pet
         virtual void SaveToDB(uint32 mapid, uint8 spawnMask, uint32 phaseMask);
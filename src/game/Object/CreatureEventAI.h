@@ -701,6 +701,16 @@ class CreatureEventAI : public CreatureAI
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
         CreatureEventAIList m_CreatureEventAIList;          // Holder for events (stores enabled, time, and eventid)
 
+        // Events grouped by type, so hooks only visit the events they can trigger
+        // Built once in the constructor, m_CreatureEventAIList is never resized afterwards
+        typedef std::vector<CreatureEventAIHolder*> CreatureEventAIIndex;
+        CreatureEventAIIndex m_EventIndex;                  // Holders ordered by event type, list order kept within a type
+        uint16 m_EventIndexOffset[EVENT_T_END + 1];         // Events of type T are m_EventIndex[m_EventIndexOffset[T] .. m_EventIndexOffset[T + 1])
+
+        void BuildEventIndex();
+        CreatureEventAIIndex::const_iterator EventsBegin(EventAI_Type type) const { return m_EventIndex.begin() + m_EventIndexOffset[type]; }
+        CreatureEventAIIndex::const_iterator EventsEnd(EventAI_Type type) const { return m_EventIndex.begin() + m_EventIndexOffset[type + 1]; }
+
         uint8  m_Phase;                                     // Current phase, max 32 phases
         bool   m_MeleeEnabled;                              // If we allow melee auto attack
         bool   m_DynamicMovement;                           // Core will control creatures movement if this is enabled
@@ -755,6 +755,11 @@ bool GameObject::LoadFromDB(uint32 guid, Map* map)
         return false;
     }
 
+    return LoadFromDB(guid, data, map);
+}
+
+bool GameObject::LoadFromDB(uint32 guid, GameObjectData const* data, Map* map)
+{
     uint32 entry = data->id;
     // uint32 map_id = data->mapid;                         // already used before call
     uint32 phaseMask = data->phaseMask;
@@ -2276,7 +2281,14 @@ void GameObject::UpdateCollisionState() const
         return;
     }
 
-    m_model->enable(IsCollisionEnabled() ? GetPhaseMask() : 0);
+    uint32 phaseMask = IsCollisionEnabled() ? GetPhaseMask() : 0;
+    if (m_model->GetPhaseMask() == phaseMask)
+    {
+        return;
+    }
+
+    m_model->enable(phaseMask);
+    GetMap()->InvalidateLineOfSightCache();
 }
 
 void GameObject::UpdateModel()
@@ -666,6 +666,7 @@ class GameObject : public WorldObject
         void SaveToDB();
         void SaveToDB(uint32 mapid, uint8 spawnMask, uint32 phaseMask);
         bool LoadFromDB(uint32 guid, Map* map);
+        bool LoadFromDB(uint32 guid, GameObjectData const* data, Map* map); // data already looked up, used by grid loading
         void DeleteFromDB();
 
         // z_rot, y_rot, x_rot - rotation angles around z, y and x axes
@@ -57,6 +57,7 @@ void MemberSlot::UpdateLogoutTime()
 void MemberSlot::SetPNOTE(std::string pnote)
 {
     Pnote = pnote;
+    guild->InvalidateRoster();
 
     // pnote now can be used for encoding to DB
     CharacterDatabase.escape_string(pnote);
@@ -66,6 +67,7 @@ void MemberSlot::SetPNOTE(std::string pnote)
 void MemberSlot::SetOFFNOTE(std::string offnote)
 {
     OFFnote = offnote;
+    guild->InvalidateRoster();
 
     // offnote now can be used for encoding to DB
     CharacterDatabase.escape_string(offnote);
@@ -75,6 +77,8 @@ void MemberSlot::SetOFFNOTE(std::string offnote)
 void MemberSlot::ChangeRank(uint32 newRank)
 {
     RankId = newRank;
+    guild->InvalidateRoster();
+    guild->InvalidateChatListeners();
 
     Player* player = sObjectMgr.GetPlayer(guid);
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
@@ -103,6 +107,10 @@ Guild::Guild()
 
     m_CreatedDate = 0;
 
+    m_chatListenersDirty = true;
+    m_rosterDirty = true;
+    m_rosterBuildTime = 0;
+
     m_GuildBankMoney = 0;
 
     m_GuildEventLogNextGuid = 0;
@@ -211,6 +219,7 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
     // fill player data
     MemberSlot newmember;
 
+    newmember.guild = this;
     newmember.guid = plGuid;
 
     if (pl)
@@ -272,6 +281,8 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
         pl->SetGuildLevel(GetLevel());
         pl->SetRank(newmember.RankId);
         pl->SetGuildIdInvited(0);
+
+        OnMemberLogin(pl);
     }
 
     UpdateAccountsNumber();
@@ -290,6 +301,7 @@ bool Guild::AddMember(ObjectGuid plGuid, uint32 plRank)
 void Guild::SetMOTD(std::string motd)
 {
     MOTD = motd;
+    InvalidateRoster();
 
     // motd now can be used for encoding to DB
     CharacterDatabase.escape_string(motd);
@@ -307,6 +319,7 @@ void Guild::SetMOTD(std::string motd)
 void Guild::SetGINFO(std::string ginfo)
 {
     GINFO = ginfo;
+    InvalidateRoster();
 
     // ginfo now can be used for encoding to DB
     CharacterDatabase.escape_string(ginfo);
@@ -508,6 +521,7 @@ bool Guild::LoadMembersFromDB(QueryResult* guildMembersResult)
         }
 
         MemberSlot newmember;
+        newmember.guild = this;
         uint32 lowguid = fields[1].GetUInt32();
         newmember.guid = ObjectGuid(HIGHGUID_PLAYER, lowguid);
         newmember.RankId = fields[2].GetUInt32();
@@ -639,11 +653,14 @@ bool Guild::DelMember(ObjectGuid guid, bool isDisbanding)
     }
 
     members.erase(lowguid);
+    InvalidateRoster();
 
     Player* player = sObjectMgr.GetPlayer(guid);
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
     if (player)
     {
+        OnMemberLogout(player);
+
         player->SetInGuild(0);
         player->SetGuildLevel(0);
         player->SetRank(0);
@@ -694,13 +711,13 @@ void Guild::BroadcastToGuild(WorldSession* session, const std::string& msg, uint
     WorldPacket data;
     ChatHandler::BuildChatPacket(data, CHAT_MSG_GUILD, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
-    {
-        Player* pl = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+    UpdateChatListeners();
 
-        if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
+    for (OnlineMemberList::const_iterator itr = m_guildChatListeners.begin(); itr != m_guildChatListeners.end(); ++itr)
+    {
+        if (!(*itr)->GetSocial()->HasIgnore(player->GetObjectGuid()))
         {
-            pl->GetSession()->SendPacket(&data);
+            (*itr)->GetSession()->SendPacket(&data);
         }
     }
 }
@@ -712,13 +729,13 @@ void Guild::BroadcastAddonToGuild(WorldSession* session, const std::string& msg,
         WorldPacket data;
         ChatHandler::BuildChatPacket(data, CHAT_MSG_GUILD, msg.c_str(), LANG_ADDON, CHAT_TAG_NONE, ObjectGuid(), NULL, ObjectGuid(), NULL, NULL, 0, prefix.c_str());
 
-        for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
-        {
-            Player* pl = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+        UpdateChatListeners();
 
-            if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_GCHATLISTEN) && !pl->GetSocial()->HasIgnore(session->GetPlayer()->GetObjectGuid()))
+        for (OnlineMemberList::const_iterator itr = m_guildChatListeners.begin(); itr != m_guildChatListeners.end(); ++itr)
+        {
+            if (!(*itr)->GetSocial()->HasIgnore(session->GetPlayer()->GetObjectGuid()))
             {
-                pl->GetSession()->SendPacket(&data);
+                (*itr)->GetSession()->SendPacket(&data);
             }
         }
     }
@@ -737,16 +754,16 @@ void Guild::BroadcastToOfficers(WorldSession* session, const std::string& msg, u
         return;
     }
 
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
-    {
-        WorldPacket data;
-        ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
+    WorldPacket data;
+    ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), Language(language), player->GetChatTag(), player->GetObjectGuid(), player->GetName());
 
-        Player* pl = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+    UpdateChatListeners();
 
-        if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(player->GetObjectGuid()))
+    for (OnlineMemberList::const_iterator itr = m_officerChatListeners.begin(); itr != m_officerChatListeners.end(); ++itr)
+    {
+        if (!(*itr)->GetSocial()->HasIgnore(player->GetObjectGuid()))
         {
-            pl->GetSession()->SendPacket(&data);
+            (*itr)->GetSession()->SendPacket(&data);
         }
     }
 }
@@ -755,16 +772,16 @@ void Guild::BroadcastAddonToOfficers(WorldSession* session, const std::string& m
 {
     if (session && session->GetPlayer() && HasRankRight(session->GetPlayer()->GetRank(), GR_RIGHT_OFFCHATSPEAK))
     {
-        for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
-        {
-            WorldPacket data;
-            ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), LANG_ADDON, CHAT_TAG_NONE, ObjectGuid(), NULL, ObjectGuid(), NULL, NULL, 0, prefix.c_str());
+        WorldPacket data;
+        ChatHandler::BuildChatPacket(data, CHAT_MSG_OFFICER, msg.c_str(), LANG_ADDON, CHAT_TAG_NONE, ObjectGuid(), NULL, ObjectGuid(), NULL, NULL, 0, prefix.c_str());
 
-            Player* pl = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
+        UpdateChatListeners();
 
-            if (pl && pl->GetSession() && HasRankRight(pl->GetRank(), GR_RIGHT_OFFCHATLISTEN) && !pl->GetSocial()->HasIgnore(session->GetPlayer()->GetObjectGuid()))
+        for (OnlineMemberList::const_iterator itr = m_officerChatListeners.begin(); itr != m_officerChatListeners.end(); ++itr)
+        {
+            if (!(*itr)->GetSocial()->HasIgnore(session->GetPlayer()->GetObjectGuid()))
             {
-                pl->GetSession()->SendPacket(&data);
+                (*itr)->GetSession()->SendPacket(&data);
             }
         }
     }
@@ -772,29 +789,74 @@ void Guild::BroadcastAddonToOfficers(WorldSession* session, const std::string& m
 
 void Guild::BroadcastPacket(WorldPacket* packet)
 {
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
     {
-        Player* player = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-        if (player)
+        (*itr)->GetSession()->SendPacket(packet);
+    }
+}
+
+void Guild::BroadcastPacketToRank(WorldPacket* packet, uint32 rankId)
+{
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+    {
+        if ((*itr)->GetRank() == rankId)
         {
-            player->GetSession()->SendPacket(packet);
+            (*itr)->GetSession()->SendPacket(packet);
         }
     }
 }
 
-void Guild::BroadcastPacketToRank(WorldPacket* packet, uint32 rankId)
+void Guild::OnMemberLogin(Player* player)
 {
-    for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    if (std::find(m_onlineMembers.begin(), m_onlineMembers.end(), player) == m_onlineMembers.end())
     {
-        if (itr->second.RankId == rankId)
+        m_onlineMembers.push_back(player);
+    }
+
+    InvalidateRoster();
+    InvalidateChatListeners();
+}
+
+void Guild::OnMemberLogout(Player* player)
+{
+    OnlineMemberList::iterator itr = std::find(m_onlineMembers.begin(), m_onlineMembers.end(), player);
+    if (itr != m_onlineMembers.end())
+    {
+        // order doesn't matter, swap with last to avoid shifting
+        *itr = m_onlineMembers.back();
+        m_onlineMembers.pop_back();
+    }
+
+    InvalidateRoster();
+    InvalidateChatListeners();
+}
+
+void Guild::UpdateChatListeners()
+{
+    if (!m_chatListenersDirty)
+    {
+        return;
+    }
+
+    m_guildChatListeners.clear();
+    m_officerChatListeners.clear();
+
+    for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+    {
+        uint32 rights = GetRankRights((*itr)->GetRank());
+
+        if ((rights & GR_RIGHT_GCHATLISTEN) != GR_RIGHT_EMPTY)
         {
-            Player* player = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
-            if (player)
-            {
-                player->GetSession()->SendPacket(packet);
-            }
+            m_guildChatListeners.push_back(*itr);
+        }
+
+        if ((rights & GR_RIGHT_OFFCHATLISTEN) != GR_RIGHT_EMPTY)
+        {
+            m_officerChatListeners.push_back(*itr);
         }
     }
+
+    m_chatListenersDirty = false;
 }
 
 // add new event to all already connected guild memebers
@@ -873,6 +935,7 @@ void Guild::DelRank(uint32 rankId)
     }
 
     RankList::iterator itr = m_Ranks.erase(m_Ranks.begin() + rankId);
+    InvalidateChatListeners();
     // delete lowest guild_rank
     CharacterDatabase.BeginTransaction();
     CharacterDatabase.PExecute("DELETE FROM `guild_rank` WHERE `rid` ='%u' AND `guildid` ='%u'", rankId, m_Id);
@@ -898,6 +961,7 @@ void Guild::SwitchRank(uint32 rankId, bool up)
     DEBUG_LOG("rank: %u otherrank %u", rankId, otherRankId);
 
     std::swap(m_Ranks[rankId], m_Ranks[otherRankId]);
+    InvalidateChatListeners();
 
     CharacterDatabase.BeginTransaction();
     for (uint32 i = 0; i < uint32(GetPurchasedTabs()); ++i)
@@ -968,6 +1032,7 @@ void Guild::SetRankRights(uint32 rankId, uint32 rights)
     }
 
     m_Ranks[rankId].Rights = rights;
+    InvalidateChatListeners();
 
     CharacterDatabase.PExecute("UPDATE `guild_rank` SET `rights`='%u' WHERE `rid`='%u' AND `guildid`='%u'", rights, rankId, m_Id);
 }
@@ -1013,17 +1078,39 @@ void Guild::Disband()
 }
 
 void Guild::Roster(WorldSession* session /*= NULL*/)
+{
+    // rebuilt only when something shown in it changed, big guilds open the tab a lot
+    time_t now = time(NULL);
+    if (m_rosterDirty || now >= m_rosterBuildTime + GUILD_ROSTER_CACHE_TIME)
+    {
+        BuildRosterPacket(m_rosterPacket);
+        m_rosterDirty = false;
+        m_rosterBuildTime = now;
+    }
+
+    if (session)
+    {
+        session->SendPacket(&m_rosterPacket);
+    }
+    else
+    {
+        BroadcastPacket(&m_rosterPacket);
+    }
+    DEBUG_LOG("WORLD: Sent (SMSG_GUILD_ROSTER)");
+}
+
+void Guild::BuildRosterPacket(WorldPacket& data)
 {
     ByteBuffer buffer;
 
     // we can only guess size
-    WorldPacket data(SMSG_GUILD_ROSTER, (4 + MOTD.length() + 1 + GINFO.length() + 1 + 4 + members.size() * 50));
+    data.Initialize(SMSG_GUILD_ROSTER, (4 + MOTD.length() + 1 + GINFO.length() + 1 + 4 + members.size() * 50));
     data.WriteBits(MOTD.length(), 11);
     data.WriteBits(members.size(), 18);
 
     for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
     {
-        MemberSlot const member = itr->second;
+        MemberSlot const& member = itr->second;
         Player* player = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
 
         ObjectGuid guid = member.guid;
@@ -1096,16 +1183,6 @@ void Guild::Roster(WorldSession* session /*= NULL*/)
     data << uint32(0);                                      // weekly rep cap
     data << secsToTimeBitFields(m_CreatedDate);
     data << uint32(0);
-
-    if (session)
-    {
-        session->SendPacket(&data);
-    }
-    else
-    {
-        BroadcastPacket(&data);
-    }
-    DEBUG_LOG("WORLD: Sent (SMSG_GUILD_ROSTER)");
 }
 
 void Guild::Query(WorldSession* session)
@@ -28,12 +28,17 @@
 #define WITHDRAW_MONEY_UNLIMITED    UI64LIT(0xFFFFFFFFFFFFFFFF)
 #define WITHDRAW_SLOT_UNLIMITED     0xFFFFFFFF
 
+// cached roster packet is rebuilt at least this often, offline members show the time since their logout
+#define GUILD_ROSTER_CACHE_TIME     MINUTE
+
 #include "Common.h"
 #include "Item.h"
 #include "ObjectAccessor.h"
 #include "SharedDefines.h"
+#include "WorldPacket.h"
 
 class Item;
+class Guild;
 
 #define GUILD_RANK_NONE         0xFF
 
@@ -297,6 +302,7 @@ struct MemberSlot
     void SetOFFNOTE(std::string offnote);
     void ChangeRank(uint32 newRank);
 
+    Guild* guild;                                           // owner, told about changes shown in the roster
     ObjectGuid guid;
     uint32 accountId;
     std::string Name;
@@ -398,14 +404,22 @@ class Guild
         template<class Do>
         void BroadcastWorker(Do& _do, Player* except = NULL)
         {
-            for (MemberList::iterator itr = members.begin(); itr != members.end(); ++itr)
-                if (Player* player = sObjectAccessor.FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first)))
-                    if (player != except)
-                    {
-                        _do(player);
-                    }
+            for (OnlineMemberList::const_iterator itr = m_onlineMembers.begin(); itr != m_onlineMembers.end(); ++itr)
+                if (*itr != except)
+                {
+                    _do(*itr);
+                }
         }
 
+        // online members are tracked from login to logout, broadcasts only walk them
+        void OnMemberLogin(Player* player);
+        void OnMemberLogout(Player* player);
+
+        // something shown in the roster changed, the cached packet is rebuilt at next request
+        void InvalidateRoster() { m_rosterDirty = true; }
+        // rank or rank rights of members changed, chat listener lists are rebuilt at next chat message
+        void InvalidateChatListeners() { m_chatListenersDirty = true; }
+
         void CreateRank(std::string name, uint32 rights);
         void DelRank(uint32 rankId);
         void SwitchRank(uint32 rankId, bool up);
@@ -527,6 +541,16 @@ class Guild
 
         MemberList members;
 
+        typedef std::vector<Player*> OnlineMemberList;
+        OnlineMemberList m_onlineMembers;
+        OnlineMemberList m_guildChatListeners;              // online members with GR_RIGHT_GCHATLISTEN
+        OnlineMemberList m_officerChatListeners;            // online members with GR_RIGHT_OFFCHATLISTEN
+        bool m_chatListenersDirty;
+
+        WorldPacket m_rosterPacket;                         // cached SMSG_GUILD_ROSTER
+        bool m_rosterDirty;
+        time_t m_rosterBuildTime;
+
         typedef std::vector<GuildBankTab*> TabListMap;
         TabListMap m_TabListMap;
 
@@ -544,7 +568,9 @@ class Guild
         uint64 m_GuildBankMoney;
 
     private:
-        void UpdateAccountsNumber() { m_accountsNumber = 0;}// mark for lazy calculation at request in GetAccountsNumber
+        void UpdateAccountsNumber() { m_accountsNumber = 0; m_rosterDirty = true; }// mark for lazy calculation at request in GetAccountsNumber
+        void BuildRosterPacket(WorldPacket& data);
+        void UpdateChatListeners();
         void _ChangeRank(ObjectGuid guid, MemberSlot* slot, uint32 newRank);
 
         // used only from high level Swap/Move functions
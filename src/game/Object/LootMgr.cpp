@@ -61,6 +61,7 @@ class LootTemplate::LootGroup                               // A set of loot def
 {
     public:
         void AddEntry(LootStoreItem& item);                 // Adds an entry to the group (at loading stage)
+        void Compile();                                     // Builds the roll table from the entries (after loading stage)
         bool HasQuestDrop() const;                          // True if group includes at least 1 quest drop entry
         bool HasQuestDropForPlayer(Player const* player) const; // The same for active quests of the player
         // The same for active quests of the player
@@ -75,6 +76,10 @@ class LootTemplate::LootGroup                               // A set of loot def
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
 
+        // Alias table over all outcomes of the group: ExplicitlyChanced entries, then EqualChanced entries, then the empty drop
+        std::vector<float>  AliasChance;                    // chance to keep the rolled column (0..1)
+        std::vector<uint32> AliasOutcome;                   // outcome taken when the column is not kept
+
         LootStoreItem const* Roll() const;                  // Rolls an item from the group, returns NULL if all miss their chances
 };
 
@@ -183,6 +188,11 @@ void LootStore::LoadLootTable()
 
         delete result;
 
+        for (LootTemplateMap::const_iterator itr = m_LootTemplates.begin(); itr != m_LootTemplates.end(); ++itr)
+        {
+            itr->second->Compile();                         // Builds the group roll tables
+        }
+
         Verify();                                           // Checks validity of the loot store
 
         sLog.outString();
@@ -1115,30 +1125,84 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem& item)
     }
 }
 
-// Rolls an item from the group, returns NULL if all miss their chances
-LootStoreItem const* LootTemplate::LootGroup::Roll() const
+// Builds the alias table for Roll() (Vose's alias method), must be called after all entries are added
+void LootTemplate::LootGroup::Compile()
 {
-    if (!ExplicitlyChanced.empty())                         // First explicitly chanced entries are checked
+    uint32 explicitCount = ExplicitlyChanced.size();
+    uint32 outcomeCount = explicitCount + EqualChanced.size() + 1;
+
+    // Chance of every outcome, the same as a sequential roll over the entries gives:
+    // explicitly chanced entries are checked in order until 100% is used up (an entry with 100% takes all that is left),
+    // what remains is shared by the equal chanced entries or is the chance of an empty drop
+    std::vector<float> weights(outcomeCount, 0.0f);
+    float remaining = 100.0f;
+    for (uint32 i = 0; i < explicitCount && remaining > 0.0f; ++i)
     {
-        float Roll = rand_chance_f();
+        weights[i] = ExplicitlyChanced[i].chance >= 100.0f ? remaining : std::min(ExplicitlyChanced[i].chance, remaining);
+        remaining -= weights[i];
+    }
 
-        for (uint32 i = 0; i < ExplicitlyChanced.size(); ++i) // check each explicitly chanced entry in the template and modify its chance based on quality.
+    if (remaining > 0.0f)
+    {
+        if (!EqualChanced.empty())
         {
-            if (ExplicitlyChanced[i].chance >= 100.0f)
-            {
-                return &ExplicitlyChanced[i];
-            }
-
-            Roll -= ExplicitlyChanced[i].chance;
-            if (Roll < 0)
+            for (uint32 i = 0; i < EqualChanced.size(); ++i)
             {
-                return &ExplicitlyChanced[i];
+                weights[explicitCount + i] = remaining / EqualChanced.size();
             }
         }
+        else
+        {
+            weights[outcomeCount - 1] = remaining;
+        }
+    }
+
+    // Scale to an average of 1 per column, then let every column under 1 borrow the rest from a column over 1
+    std::vector<uint32> small, large;
+    for (uint32 i = 0; i < outcomeCount; ++i)
+    {
+        weights[i] *= outcomeCount / 100.0f;
+        (weights[i] < 1.0f ? small : large).push_back(i);
+    }
+
+    AliasChance.assign(outcomeCount, 1.0f);
+    AliasOutcome.resize(outcomeCount);
+    for (uint32 i = 0; i < outcomeCount; ++i)
+    {
+        AliasOutcome[i] = i;
+    }
+
+    while (!small.empty() && !large.empty())
+    {
+        uint32 less = small.back();
+        small.pop_back();
+        uint32 more = large.back();
+        large.pop_back();
+
+        AliasChance[less] = weights[less];
+        AliasOutcome[less] = more;
+
+        weights[more] -= 1.0f - weights[less];
+        (weights[more] < 1.0f ? small : large).push_back(more);
+    }
+    // columns left in either list are 1 up to rounding errors and keep their own outcome
+}
+
+// Rolls an item from the group, returns NULL if all miss their chances
+LootStoreItem const* LootTemplate::LootGroup::Roll() const
+{
+    uint32 column = urand(0, AliasOutcome.size() - 1);
+    uint32 outcome = rand_norm_f() < AliasChance[column] ? column : AliasOutcome[column];
+
+    if (outcome < ExplicitlyChanced.size())
+    {
+        return &ExplicitlyChanced[outcome];
     }
-    if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
+
+    outcome -= ExplicitlyChanced.size();
+    if (outcome < EqualChanced.size())
     {
-        return &EqualChanced[irand(0, EqualChanced.size() - 1)];
+        return &EqualChanced[outcome];
     }
 
     return NULL;                                            // Empty drop from the group
@@ -1281,6 +1345,15 @@ void LootTemplate::AddEntry(LootStoreItem& item)
     }
 }
 
+// Builds the roll tables of all groups (after loading stage)
+void LootTemplate::Compile()
+{
+    for (LootGroups::iterator i = Groups.begin(); i != Groups.end(); ++i)
+    {
+        i->Compile();
+    }
+}
+
 // Rolls for every item in the template and adds the rolled items the the loot
 void LootTemplate::Process(Loot& loot, LootStore const& store, bool rate, uint8 groupId) const
 {
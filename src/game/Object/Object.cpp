@@ -68,6 +68,7 @@ Object::Object(): m_updateFlag(0)
 
     m_inWorld           = false;
     m_objectUpdated     = false;
+    m_clientUpdateSlot  = 0;
 }
 
 Object::~Object()
@@ -131,8 +132,14 @@ void Object::SendForcedObjectUpdate()
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
     for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
+        Player* player = sObjectAccessor.FindPlayer(iter->first);
+        if (!player)
+        {
+            continue;
+        }
+
         iter->second.BuildPacket(&packet);
-        iter->first->GetSession()->SendPacket(&packet);
+        player->GetSession()->SendPacket(&packet);
         packet.clear();                                     // clean the string
     }
 }
@@ -1148,16 +1155,21 @@ bool Object::PrintEntryError(char const* descr) const
 
 void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players)
 {
-    UpdateDataMapType::iterator iter = update_players.find(pl);
+    UpdateDataMapType::iterator iter = update_players.find(pl->GetObjectGuid());
 
     if (iter == update_players.end())
     {
-        std::pair<UpdateDataMapType::iterator, bool> p = update_players.insert(UpdateDataMapType::value_type(pl, UpdateData(pl->GetMapId())));
+        std::pair<UpdateDataMapType::iterator, bool> p = update_players.insert(UpdateDataMapType::value_type(pl->GetObjectGuid(), UpdateData(pl->GetMapId())));
         MANGOS_ASSERT(p.second);
         iter = p.first;
     }
+    else if (!iter->second.HasData())
+    {
+        // reused update data of the map, the player may have been teleported since its last packet
+        iter->second.SetMapId(pl->GetMapId());
+    }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    BuildValuesUpdateBlockForPlayer(&iter->second, pl);
 }
 
 void Object::AddToClientUpdateList()
@@ -1872,6 +1884,15 @@ void WorldObject::SendMessageToSetExcept(WorldPacket* data, Player const* skippe
     }
 }
 
+void WorldObject::SendMovementMessageToSetExcept(WorldPacket* data, Player const* skipped_receiver, uint32 heartbeat) const
+{
+    if (IsInWorld())
+    {
+        MaNGOS::MovementMessageDeliverer notifier(this, data, skipped_receiver, heartbeat);
+        Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
+    }
+}
+
 void WorldObject::SendObjectDeSpawnAnim(ObjectGuid guid)
 {
     WorldPacket data(SMSG_GAMEOBJECT_DESPAWN_ANIM, 8);
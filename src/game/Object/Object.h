@@ -102,7 +102,7 @@ class LuaVal;
 class TransportInfo;
 struct MangosStringLocale;
 
-typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
+typedef std::unordered_map<ObjectGuid, UpdateData> UpdateDataMapType;   // player guid, players may leave before the data is sent
 
 struct Position
 {
@@ -201,6 +201,10 @@ class Object
         void MarkForClientUpdate();
         void SendForcedObjectUpdate();
 
+        // position in the client update list of the map, only meaningful while m_objectUpdated is set
+        void SetClientUpdateSlot(uint32 slot) { m_clientUpdateSlot = slot; }
+        uint32 GetClientUpdateSlot() const { return m_clientUpdateSlot; }
+
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
 
@@ -487,6 +491,7 @@ class Object
         uint16 m_valuesCount;
 
         bool m_objectUpdated;
+        uint32 m_clientUpdateSlot;
 
     private:
         bool m_inWorld;
@@ -663,6 +668,8 @@ class WorldObject : public Object
         virtual void SendMessageToSet(WorldPacket* data, bool self) const;
         virtual void SendMessageToSetInRange(WorldPacket* data, float dist, bool self) const;
         void SendMessageToSetExcept(WorldPacket* data, Player const* skipped_receiver) const;
+        // heartbeat is the running number of a plain movement heartbeat, 0 for packets every observer must get
+        void SendMovementMessageToSetExcept(WorldPacket* data, Player const* skipped_receiver, uint32 heartbeat) const;
 
         void MonsterSay(const char* text, uint32 language, Unit const* target = NULL) const;
         void MonsterYell(const char* text, uint32 language, Unit const* target = NULL) const;
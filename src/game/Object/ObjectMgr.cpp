@@ -1673,6 +1673,31 @@ void ObjectMgr::LoadCreatures()
     sLog.outString();
 }
 
+template<class D>
+static void AddCellSpawn(std::vector<CellSpawnEntry<D> >& spawns, uint32 guid, D const* data)
+{
+    CellSpawnEntry<D> entry(guid, data);
+    typename std::vector<CellSpawnEntry<D> >::iterator itr = std::lower_bound(spawns.begin(), spawns.end(), entry);
+    if (itr != spawns.end() && itr->guid == guid)
+    {
+        itr->data = data;
+    }
+    else
+    {
+        spawns.insert(itr, entry);
+    }
+}
+
+template<class D>
+static void RemoveCellSpawn(std::vector<CellSpawnEntry<D> >& spawns, uint32 guid)
+{
+    typename std::vector<CellSpawnEntry<D> >::iterator itr = std::lower_bound(spawns.begin(), spawns.end(), CellSpawnEntry<D>(guid, NULL));
+    if (itr != spawns.end() && itr->guid == guid)
+    {
+        spawns.erase(itr);
+    }
+}
+
 void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
 {
     uint8 mask = data->spawnMask;
@@ -1684,7 +1709,7 @@ void ObjectMgr::AddCreatureToGrid(uint32 guid, CreatureData const* data)
             uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
             CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(data->mapid, i)][cell_id];
-            cell_guids.creatures.insert(guid);
+            AddCellSpawn(cell_guids.creatures, guid, data);
         }
     }
 }
@@ -1700,7 +1725,7 @@ void ObjectMgr::RemoveCreatureFromGrid(uint32 guid, CreatureData const* data)
             uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
             CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(data->mapid, i)][cell_id];
-            cell_guids.creatures.erase(guid);
+            RemoveCellSpawn(cell_guids.creatures, guid);
         }
     }
 }
@@ -1926,7 +1951,7 @@ void ObjectMgr::AddGameobjectToGrid(uint32 guid, GameObjectData const* data)
             uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
             CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(data->mapid, i)][cell_id];
-            cell_guids.gameobjects.insert(guid);
+            AddCellSpawn(cell_guids.gameobjects, guid, data);
         }
     }
 }
@@ -1942,7 +1967,7 @@ void ObjectMgr::RemoveGameobjectFromGrid(uint32 guid, GameObjectData const* data
             uint32 cell_id = (cell_pair.y_coord * TOTAL_NUMBER_OF_CELLS_PER_MAP) + cell_pair.x_coord;
 
             CellObjectGuids& cell_guids = mMapObjectGuids[MAKE_PAIR32(data->mapid, i)][cell_id];
-            cell_guids.gameobjects.erase(guid);
+            RemoveCellSpawn(cell_guids.gameobjects, guid);
         }
     }
 }
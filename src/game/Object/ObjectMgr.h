@@ -118,11 +118,27 @@ struct AreaTrigger
     }
 };
 
+// static spawn of a grid cell, data points into the ObjectMgr spawn data storage
+template<class D>
+struct CellSpawnEntry
+{
+    CellSpawnEntry(uint32 _guid, D const* _data) : guid(_guid), data(_data) {}
+
+    bool operator<(CellSpawnEntry const& other) const { return guid < other.guid; }
+
+    uint32 guid;
+    D const* data;
+};
+
+// kept sorted by guid, cells are small and loaded far more often than changed
+typedef std::vector<CellSpawnEntry<CreatureData> > CellCreatureSpawnList;
+typedef std::vector<CellSpawnEntry<GameObjectData> > CellGameObjectSpawnList;
+
 typedef std::map < uint32/*player guid*/, uint32/*instance*/ > CellCorpseSet;
 struct CellObjectGuids
 {
-    CellGuidSet creatures;
-    CellGuidSet gameobjects;
+    CellCreatureSpawnList creatures;
+    CellGameObjectSpawnList gameobjects;
     CellCorpseSet corpses;
 };
 typedef std::unordered_map < uint32/*cell_id*/, CellObjectGuids > CellObjectGuidsMap;
@@ -75,6 +75,7 @@
 #include "Vehicle.h"
 #include "Calendar.h"
 #include "DisableMgr.h"
+#include "WhoListMgr.h"
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #endif /* ENABLE_ELUNA */
@@ -394,6 +395,7 @@ Player::Player(WorldSession* session): Unit(), m_mover(this), m_camera(this), m_
     //////////////////// Rest System/////////////////////
 
     m_mailsUpdated = false;
+    m_mailsLoaded = false;
     unReadMails = 0;
     m_nextMailDelivereTime = 0;
 
@@ -416,6 +418,7 @@ Player::Player(WorldSession* session): Unit(), m_mover(this), m_camera(this), m_
     m_raidDifficulty = RAID_DIFFICULTY_10MAN_NORMAL;
 
     m_lastPotionId = 0;
+    m_spellCooldownsChanged = true;
 
     m_activeSpec = 0;
     m_specsCount = 1;
@@ -1700,6 +1703,11 @@ void Player::ToggleAFK()
 {
     ToggleFlag(PLAYER_FLAGS, PLAYER_FLAGS_AFK);
 
+    if (Guild* guild = sGuildMgr.GetGuildById(GetGuildId()))
+    {
+        guild->InvalidateRoster();
+    }
+
     // afk player not allowed in battleground
     if (isAFK() && InBattleGround() && !InArena())
     {
@@ -1710,6 +1718,11 @@ void Player::ToggleAFK()
 void Player::ToggleDND()
 {
     ToggleFlag(PLAYER_FLAGS, PLAYER_FLAGS_DND);
+
+    if (Guild* guild = sGuildMgr.GetGuildById(GetGuildId()))
+    {
+        guild->InvalidateRoster();
+    }
 }
 
 ChatTagFlags Player::GetChatTag() const
@@ -3351,6 +3364,26 @@ void Player::UpdateNextMailTimeAndUnreads()
     time_t cTime = time(NULL);
     m_nextMailDelivereTime = 0;
     unReadMails = 0;
+
+    if (!m_mailsLoaded)
+    {
+        for (PlayerMailIndex::const_iterator itr = m_mailIndex.begin(); itr != m_mailIndex.end(); ++itr)
+        {
+            if (itr->deliver_time > cTime)
+            {
+                if (!m_nextMailDelivereTime || m_nextMailDelivereTime > itr->deliver_time)
+                {
+                    m_nextMailDelivereTime = itr->deliver_time;
+                }
+            }
+            else if ((itr->checked & MAIL_CHECK_MASK_READ) == 0)
+            {
+                ++unReadMails;
+            }
+        }
+        return;
+    }
+
     for (PlayerMails::iterator itr = m_mail.begin(); itr != m_mail.end(); ++itr)
     {
         if ((*itr)->deliver_time > cTime)
@@ -4156,7 +4189,10 @@ void Player::removeSpell(uint32 spell_id, bool disabled, bool learn_low_rank, bo
 
 void Player::RemoveSpellCooldown(uint32 spell_id, bool update /* = false */)
 {
-    m_spellCooldowns.erase(spell_id);
+    if (m_spellCooldowns.erase(spell_id))
+    {
+        m_spellCooldownsChanged = true;
+    }
 
     if (update)
     {
@@ -4230,6 +4266,7 @@ void Player::RemoveAllSpellCooldown()
         SendDirectMessage(&data);
 
         m_spellCooldowns.clear();
+        m_spellCooldownsChanged = true;
     }
 }
 
@@ -4275,32 +4312,51 @@ void Player::_LoadSpellCooldowns(QueryResult* result)
 
 void Player::_SaveSpellCooldowns()
 {
-    static SqlStatementID deleteSpellCooldown ;
-    static SqlStatementID insertSpellCooldown ;
-
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM `character_spell_cooldown` WHERE `guid` = ?");
-    stmt.PExecute(GetGUIDLow());
-
     time_t curTime = time(NULL);
     time_t infTime = curTime + infinityCooldownDelayCheck;
 
-    // remove outdated and save active
+    // outdated cooldowns are skipped at load, so dropping them does not need a DB update
     for (SpellCooldowns::iterator itr = m_spellCooldowns.begin(); itr != m_spellCooldowns.end();)
     {
         if (itr->second.end <= curTime)
         {
             m_spellCooldowns.erase(itr++);
         }
-        else if (itr->second.end <= infTime)                // not save locked cooldowns, it will be reset or set at reload
+        else
         {
-            stmt = CharacterDatabase.CreateStatement(insertSpellCooldown, "INSERT INTO `character_spell_cooldown` (`guid`,`spell`,`item`,`time`) VALUES( ?, ?, ?, ?)");
-            stmt.PExecute(GetGUIDLow(), itr->first, itr->second.itemid, uint64(itr->second.end));
             ++itr;
         }
-        else
+    }
+
+    // the flag is cleared by SaveToDB once the transaction is committed
+    if (!m_spellCooldownsChanged)
+    {
+        return;
+    }
+
+    static SqlStatementID deleteSpellCooldown ;
+
+    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteSpellCooldown, "DELETE FROM `character_spell_cooldown` WHERE `guid` = ?");
+    stmt.PExecute(GetGUIDLow());
+
+    // all active cooldowns go in one multi-row insert
+    std::ostringstream ss;
+    uint32 count = 0;
+
+    for (SpellCooldowns::const_iterator itr = m_spellCooldowns.begin(); itr != m_spellCooldowns.end(); ++itr)
+    {
+        if (itr->second.end > infTime)                      // not save locked cooldowns, it will be reset or set at reload
         {
-            ++itr;
+            continue;
         }
+
+        ss << (count++ ? "," : "INSERT INTO `character_spell_cooldown` (`guid`,`spell`,`item`,`time`) VALUES ")
+           << "(" << GetGUIDLow() << "," << itr->first << "," << itr->second.itemid << "," << uint64(itr->second.end) << ")";
+    }
+
+    if (count)
+    {
+        CharacterDatabase.Execute(ss.str().c_str());
     }
 }
 
@@ -4508,6 +4564,39 @@ bool Player::resetTalents(bool no_cost, bool all_specs)
     return true;
 }
 
+void Player::AddMail(Mail* mail)
+{
+    m_mail.push_front(mail);
+
+    // keep the index complete until the mailbox is loaded, the mail itself is merged in by LoadMails
+    if (!m_mailsLoaded)
+    {
+        PlayerMailIndexEntry entry;
+        entry.messageID = mail->messageID;
+        entry.sender = mail->sender;
+        entry.checked = mail->checked;
+        entry.deliver_time = mail->deliver_time;
+        entry.messageType = mail->messageType;
+        entry.stationery = mail->stationery;
+        m_mailIndex.push_front(entry);
+    }
+}
+
+void Player::LoadMails()
+{
+    if (m_mailsLoaded)
+    {
+        return;
+    }
+
+    m_mailsLoaded = true;
+    m_mailIndex.clear();
+
+    // same queries as the login holder used before, m_mail only contains mails received since login
+    _LoadMails(CharacterDatabase.PQuery("SELECT `id`,`messageType`,`sender`,`receiver`,`subject`,`body`,`expire_time`,`deliver_time`,`money`,`cod`,`checked`,`stationery`,`mailTemplateId`,`has_items` FROM `mail` WHERE `receiver` = '%u' ORDER BY `id` DESC", GetGUIDLow()));
+    _LoadMailedItems(CharacterDatabase.PQuery("SELECT `data`, `text`, `mail_id`, `item_guid`, `item_template` FROM `mail_items` JOIN `item_instance` ON `item_guid` = `guid` WHERE `receiver` = '%u'", GetGUIDLow()));
+}
+
 Mail* Player::GetMail(uint32 id)
 {
     for (PlayerMails::iterator itr = m_mail.begin(); itr != m_mail.end(); ++itr)
@@ -7737,6 +7826,8 @@ void Player::SetInGuild(uint32 GuildId)
 
     ApplyModFlag(PLAYER_FLAGS, PLAYER_FLAGS_GUILD_LEVELING_ENABLED, GuildId != 0 && sWorld.getConfig(CONFIG_BOOL_GUILD_LEVELING_ENABLED));
     SetUInt16Value(OBJECT_FIELD_TYPE, 1, GuildId != 0);
+
+    sWhoListMgr.UpdateGuild(this);
 }
 
 std::string Player::GetGuildName() const
@@ -7934,6 +8025,12 @@ void Player::UpdateZone(uint32 newZone, uint32 newArea)
         sOutdoorPvPMgr.HandlePlayerEnterZone(this, newZone);
 
         SendInitWorldStates(newZone, newArea);              // only if really enters to new zone, not just area change, works strange...
+        sWhoListMgr.UpdateZone(this, newZone);
+
+        if (Guild* guild = sGuildMgr.GetGuildById(GetGuildId()))
+        {
+            guild->InvalidateRoster();
+        }
 
         if (sWorld.getConfig(CONFIG_BOOL_WEATHER))
         {
@@ -18425,9 +18522,8 @@ bool Player::LoadFromDB(ObjectGuid guid, SqlQueryHolder* holder)
 
     // apply original stats mods before spell loading or item equipment that call before equip _RemoveStatsMods()
 
-    // Mail
-    _LoadMails(holder->GetResult(PLAYER_LOGIN_QUERY_LOADMAILS));
-    _LoadMailedItems(holder->GetResult(PLAYER_LOGIN_QUERY_LOADMAILEDITEMS));
+    // Mail, only the headers needed for the unread/next delivery state, the rest is loaded at first mailbox use
+    _LoadMailIndex(holder->GetResult(PLAYER_LOGIN_QUERY_LOADMAILINDEX));
     UpdateNextMailTimeAndUnreads();
 
     _LoadGlyphs(holder->GetResult(PLAYER_LOGIN_QUERY_LOADGLYPHS));
@@ -19188,6 +19284,12 @@ void Player::_LoadMailedItems(QueryResult* result)
         uint32 item_guid_low = fields[3].GetUInt32();
         uint32 item_template = fields[4].GetUInt32();
 
+        // item of a mail received after login, already in memory
+        if (GetMItem(item_guid_low))
+        {
+            continue;
+        }
+
         Mail* mail = GetMail(mail_id);
         if (!mail)
         {
@@ -19223,9 +19325,41 @@ void Player::_LoadMailedItems(QueryResult* result)
     delete result;
 }
 
+void Player::_LoadMailIndex(QueryResult* result)
+{
+    m_mailIndex.clear();
+    //        0  1           2      3            4       5
+    //"SELECT id,messageType,sender,deliver_time,checked,stationery FROM mail WHERE receiver = '%u' ORDER BY id DESC", GetGUIDLow()
+    if (!result)
+    {
+        return;
+    }
+
+    do
+    {
+        Field* fields = result->Fetch();
+        PlayerMailIndexEntry entry;
+        entry.messageID = fields[0].GetUInt32();
+        entry.messageType = fields[1].GetUInt8();
+        entry.sender = fields[2].GetUInt32();
+        entry.deliver_time = (time_t)fields[3].GetUInt64();
+        entry.checked = fields[4].GetUInt32();
+        entry.stationery = fields[5].GetUInt8();
+        m_mailIndex.push_back(entry);
+    }
+    while (result->NextRow());
+    delete result;
+}
+
 void Player::_LoadMails(QueryResult* result)
 {
-    m_mail.clear();
+    // mails received since login are in m_mail already, the database may contain them or not yet
+    std::set<uint32> receivedIds;
+    for (PlayerMails::const_iterator itr = m_mail.begin(); itr != m_mail.end(); ++itr)
+    {
+        receivedIds.insert((*itr)->messageID);
+    }
+
     //        0  1           2      3        4       5    6           7            8     9   10      11         12             13
     //"SELECT id,messageType,sender,receiver,subject,body,expire_time,deliver_time,money,cod,checked,stationery,mailTemplateId,has_items FROM mail WHERE receiver = '%u' ORDER BY id DESC", GetGUIDLow()
     if (!result)
@@ -19236,6 +19370,11 @@ void Player::_LoadMails(QueryResult* result)
     do
     {
         Field* fields = result->Fetch();
+        if (receivedIds.find(fields[0].GetUInt32()) != receivedIds.end())
+        {
+            continue;
+        }
+
         Mail* m = new Mail;
         m->messageID = fields[0].GetUInt32();
         m->messageType = fields[1].GetUInt8();
@@ -20054,7 +20193,10 @@ void Player::SaveToDB()
 {
     // we should assure this: ASSERT((m_nextSave != sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE)));
     // delay auto save at any saves (manual, in code, or autosave)
-    m_nextSave = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
+    // with some spread, so players saved together (login wave, saveall) drift apart instead of saving in waves forever
+    uint32 saveInterval = sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE);
+    uint32 saveSpread = saveInterval / 100 * sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE_SPREAD);
+    m_nextSave = saveSpread ? urand(saveInterval - saveSpread, saveInterval + saveSpread) : saveInterval;
 
     // lets allow only players in world to be saved
     if (IsBeingTeleportedFar())
@@ -20265,7 +20407,11 @@ void Player::SaveToDB()
     _SaveGlyphs();
     _SaveTalents();
 
-    CharacterDatabase.CommitTransaction();
+    // keep the cooldowns marked as changed if the save failed, the next save writes them again
+    if (CharacterDatabase.CommitTransaction())
+    {
+        m_spellCooldownsChanged = false;
+    }
 
     // check if stats should only be saved on logout
     // save stats can be out of transaction
@@ -20355,7 +20501,6 @@ void Player::_SaveActions()
 void Player::_SaveAuras()
 {
     static SqlStatementID deleteAuras ;
-    static SqlStatementID insertAuras ;
 
     SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM `character_aura` WHERE `guid` = ?");
     stmt.PExecute(GetGUIDLow());
@@ -20367,9 +20512,9 @@ void Player::_SaveAuras()
         return;
     }
 
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO `character_aura` (`guid`, `caster_guid`, `item_guid`, `spell`, `stackcount`, `remaincharges`, "
-            "`basepoints0`, `basepoints1`, `basepoints2`, `periodictime0`, `periodictime1`, `periodictime2`, `maxduration`, `remaintime`, `effIndexMask`) "
-            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    // all saved holders go in one multi-row insert
+    std::ostringstream ss;
+    uint32 count = 0;
 
     for (SpellAuraHolderMap::const_iterator itr = auraHolders.begin(); itr != auraHolders.end(); ++itr)
     {
@@ -20409,29 +20554,35 @@ void Player::_SaveAuras()
                 continue;
             }
 
-            stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt64(holder->GetCasterGuid().GetRawValue());
-            stmt.addUInt32(holder->GetCastItemGuid().GetCounter());
-            stmt.addUInt32(holder->GetId());
-            stmt.addUInt32(holder->GetStackAmount());
-            stmt.addUInt8(holder->GetAuraCharges());
+            ss << (count++ ? "," : "INSERT INTO `character_aura` (`guid`, `caster_guid`, `item_guid`, `spell`, `stackcount`, `remaincharges`, "
+                   "`basepoints0`, `basepoints1`, `basepoints2`, `periodictime0`, `periodictime1`, `periodictime2`, `maxduration`, `remaintime`, `effIndexMask`) VALUES ")
+               << "(" << GetGUIDLow()
+               << "," << holder->GetCasterGuid().GetRawValue()
+               << "," << holder->GetCastItemGuid().GetCounter()
+               << "," << holder->GetId()
+               << "," << holder->GetStackAmount()
+               << "," << uint32(uint8(holder->GetAuraCharges()));
 
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
             {
-                stmt.addInt32(damage[i]);
+                ss << "," << damage[i];
             }
 
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
             {
-                stmt.addUInt32(periodicTime[i]);
+                ss << "," << periodicTime[i];
             }
 
-            stmt.addInt32(holder->GetAuraMaxDuration());
-            stmt.addInt32(holder->GetAuraDuration());
-            stmt.addUInt32(effIndexMask);
-            stmt.Execute();
+            ss << "," << holder->GetAuraMaxDuration()
+               << "," << holder->GetAuraDuration()
+               << "," << effIndexMask << ")";
         }
     }
+
+    if (count)
+    {
+        CharacterDatabase.Execute(ss.str().c_str());
+    }
 }
 
 void Player::_SaveGlyphs()
@@ -22908,6 +23059,7 @@ void Player::AddSpellCooldown(uint32 spellid, uint32 itemid, time_t end_time)
     sc.end = end_time;
     sc.itemid = itemid;
     m_spellCooldowns[spellid] = sc;
+    m_spellCooldownsChanged = true;
 }
 
 void Player::SendCooldownEvent(SpellEntry const* spellInfo, uint32 itemId, Spell* spell)
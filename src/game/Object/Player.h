@@ -68,6 +68,19 @@ struct AreaTrigger;
 
 typedef std::deque<Mail*> PlayerMails;
 
+// mail header fields needed before the mailbox is opened (unread count, next delivery, new mail senders)
+struct PlayerMailIndexEntry
+{
+    uint32 messageID;
+    uint32 sender;
+    uint32 checked;
+    time_t deliver_time;
+    uint8 messageType;
+    uint8 stationery;
+};
+
+typedef std::deque<PlayerMailIndexEntry> PlayerMailIndex;
+
 #define PLAYER_MAX_SKILLS           128
 #define PLAYER_MAX_DAILY_QUESTS     25
 #define PLAYER_EXPLORED_ZONES_SIZE  156
@@ -870,8 +883,7 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOADACCOUNTDATA,
     PLAYER_LOGIN_QUERY_LOADSKILLS,
     PLAYER_LOGIN_QUERY_LOADGLYPHS,
-    PLAYER_LOGIN_QUERY_LOADMAILS,
-    PLAYER_LOGIN_QUERY_LOADMAILEDITEMS,
+    PLAYER_LOGIN_QUERY_LOADMAILINDEX,
     PLAYER_LOGIN_QUERY_LOADTALENTS,
     PLAYER_LOGIN_QUERY_LOADWEEKLYQUESTSTATUS,
     PLAYER_LOGIN_QUERY_LOADMONTHLYQUESTSTATUS,
@@ -1672,16 +1684,18 @@ class Player : public Unit
 
         void RemoveMail(uint32 id);
 
-        void AddMail(Mail* mail)
-        {
-            m_mail.push_front(mail);   // for call from WorldSession::SendMailTo
-        }
+        void AddMail(Mail* mail);                           // for call from WorldSession::SendMailTo
         uint32 GetMailSize()
         {
-            return m_mail.size();
+            return m_mailsLoaded ? m_mail.size() : m_mailIndex.size();
         }
         Mail* GetMail(uint32 id);
 
+        // mails and their items are loaded at first mailbox use, until then only m_mailIndex is known
+        void LoadMails();
+        bool IsMailsLoaded() const { return m_mailsLoaded; }
+        PlayerMailIndex const& GetMailIndex() const { return m_mailIndex; }
+
         PlayerMails::iterator GetMailBegin()
         {
             return m_mail.begin();
@@ -2656,6 +2670,7 @@ class Player : public Unit
         void _LoadBoundInstances(QueryResult* result);
         void _LoadInventory(QueryResult* result, uint32 timediff);
         void _LoadItemLoot(QueryResult* result);
+        void _LoadMailIndex(QueryResult* result);
         void _LoadMails(QueryResult* result);
         void _LoadMailedItems(QueryResult* result);
         void _LoadQuestStatus(QueryResult* result);
@@ -2750,10 +2765,13 @@ class Player : public Unit
         uint32 m_ArenaTeamIdInvited;
 
         PlayerMails m_mail;
+        PlayerMailIndex m_mailIndex;
+        bool m_mailsLoaded;
         PlayerSpellMap m_spells;
         PlayerTalentMap m_talents[MAX_TALENT_SPEC_COUNT];
         uint32 m_talentsPrimaryTree[MAX_TALENT_SPEC_COUNT];
         SpellCooldowns m_spellCooldowns;
+        bool m_spellCooldownsChanged;                       // m_spellCooldowns differs from `character_spell_cooldown`
         uint32 m_lastPotionId;                              // last used health/mana potion in combat, that block next potion use
 
         GlobalCooldownMgr m_GlobalCooldownMgr;
@@ -59,6 +59,9 @@
 #include "CreatureLinkingMgr.h"
 #include "GameTime.h"
 #include "movement/MovementStructures.h"
+#include "WhoListMgr.h"
+#include "Guild.h"
+#include "GuildMgr.h"
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #include "ElunaConfig.h"
@@ -12007,10 +12010,20 @@ void Unit::SetLevel(uint32 lvl)
 {
     SetUInt32Value(UNIT_FIELD_LEVEL, lvl);
 
-    // group update
-    if ((GetTypeId() == TYPEID_PLAYER) && ((Player*)this)->GetGroup())
+    if (GetTypeId() == TYPEID_PLAYER)
     {
-        ((Player*)this)->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
+        // group update
+        if (((Player*)this)->GetGroup())
+        {
+            ((Player*)this)->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_LEVEL);
+        }
+
+        sWhoListMgr.UpdateLevel((Player*)this);
+
+        if (Guild* guild = sGuildMgr.GetGuildById(((Player*)this)->GetGuildId()))
+        {
+            guild->InvalidateRoster();
+        }
     }
 }
 
@@ -0,0 +1,172 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "OpcodeStats.h"
+#include "Opcodes.h"
+#include "Log.h"
+#include "Util.h"
+
+#include <algorithm>
+
+INSTANTIATE_SINGLETON_1(OpcodeStatsMgr);
+
+void OpcodeStatEntry::Merge(OpcodeStatEntry const& other)
+{
+    calls += other.calls;
+    totalTime += other.totalTime;
+    maxTime = std::max(maxTime, other.maxTime);
+    bytesIn += other.bytesIn;
+    sent += other.sent;
+    bytesOut += other.bytesOut;
+}
+
+OpcodeStatsMgr::OpcodeStatsMgr() : m_resetTime(time(NULL))
+{
+}
+
+OpcodeStatsMgr::~OpcodeStatsMgr()
+{
+    for (std::vector<ThreadStats*>::iterator itr = m_threadStats.begin(); itr != m_threadStats.end(); ++itr)
+    {
+        delete *itr;
+    }
+}
+
+OpcodeStatsMgr::ThreadStats* OpcodeStatsMgr::GetThreadStats()
+{
+    // the tables are owned by the manager, threads only keep a pointer to their own one
+    static thread_local ThreadStats* threadStats = NULL;
+    if (!threadStats)
+    {
+        threadStats = new ThreadStats;
+
+        std::lock_guard<std::mutex> guard(m_threadStatsLock);
+        m_threadStats.push_back(threadStats);
+    }
+
+    return threadStats;
+}
+
+void OpcodeStatsMgr::RecordHandler(uint16 opcode, size_t bytes, uint64 time)
+{
+    ThreadStats* threadStats = GetThreadStats();
+
+    std::lock_guard<std::mutex> guard(threadStats->lock);
+    OpcodeStatEntry& entry = threadStats->stats[opcode];
+    ++entry.calls;
+    entry.totalTime += time;
+    entry.maxTime = std::max(entry.maxTime, time);
+    entry.bytesIn += bytes;
+}
+
+void OpcodeStatsMgr::RecordSend(uint16 opcode, size_t bytes)
+{
+    ThreadStats* threadStats = GetThreadStats();
+
+    std::lock_guard<std::mutex> guard(threadStats->lock);
+    OpcodeStatEntry& entry = threadStats->stats[opcode];
+    ++entry.sent;
+    entry.bytesOut += bytes;
+}
+
+void OpcodeStatsMgr::GetStats(OpcodeStatList& stats, OpcodeStatSortOrder order, uint32 count) const
+{
+    OpcodeStatMap merged;
+    {
+        std::lock_guard<std::mutex> guard(m_threadStatsLock);
+        for (std::vector<ThreadStats*>::const_iterator itr = m_threadStats.begin(); itr != m_threadStats.end(); ++itr)
+        {
+            std::lock_guard<std::mutex> threadGuard((*itr)->lock);
+            for (OpcodeStatMap::const_iterator stat = (*itr)->stats.begin(); stat != (*itr)->stats.end(); ++stat)
+            {
+                merged[stat->first].Merge(stat->second);
+            }
+        }
+    }
+
+    stats.assign(merged.begin(), merged.end());
+    std::sort(stats.begin(), stats.end(), [order](OpcodeStatList::value_type const& a, OpcodeStatList::value_type const& b)
+    {
+        switch (order)
+        {
+            case OPCODE_STATS_SORT_MAX_TIME:  return a.second.maxTime > b.second.maxTime;
+            case OPCODE_STATS_SORT_CALLS:     return a.second.calls > b.second.calls;
+            case OPCODE_STATS_SORT_BYTES_OUT: return a.second.bytesOut > b.second.bytesOut;
+            default:                          return a.second.totalTime > b.second.totalTime;
+        }
+    });
+
+    if (count && stats.size() > count)
+    {
+        stats.resize(count);
+    }
+}
+
+void OpcodeStatsMgr::Reset()
+{
+    std::lock_guard<std::mutex> guard(m_threadStatsLock);
+    for (std::vector<ThreadStats*>::iterator itr = m_threadStats.begin(); itr != m_threadStats.end(); ++itr)
+    {
+        std::lock_guard<std::mutex> threadGuard((*itr)->lock);
+        (*itr)->stats.clear();
+    }
+
+    m_resetTime = time(NULL);
+}
+
+uint32 OpcodeStatsMgr::GetCollectTime() const
+{
+    return uint32(time(NULL) - m_resetTime);
+}
+
+void OpcodeStatsMgr::WriteSnapshot() const
+{
+    if (m_snapshotFile.empty())
+    {
+        return;
+    }
+
+    std::string path = sLog.GetLogsDir() + m_snapshotFile;
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file)
+    {
+        sLog.outError("OpcodeStats: can't open %s for writing.", path.c_str());
+        return;
+    }
+
+    OpcodeStatList stats;
+    GetStats(stats, OPCODE_STATS_SORT_TOTAL_TIME);
+
+    fprintf(file, "# opcode stats written %s, collected for %u seconds\n", TimeToTimestampStr(time(NULL)).c_str(), GetCollectTime());
+    fprintf(file, "# opcode;name;calls;total_us;avg_us;max_us;bytes_in;sent;bytes_out\n");
+    for (OpcodeStatList::const_iterator itr = stats.begin(); itr != stats.end(); ++itr)
+    {
+        OpcodeStatEntry const& entry = itr->second;
+        fprintf(file, "0x%04X;%s;" UI64FMTD ";" UI64FMTD ";" UI64FMTD ";" UI64FMTD ";" UI64FMTD ";" UI64FMTD ";" UI64FMTD "\n",
+                itr->first, LookupOpcodeName(itr->first), entry.calls, entry.totalTime, entry.calls ? entry.totalTime / entry.calls : 0,
+                entry.maxTime, entry.bytesIn, entry.sent, entry.bytesOut);
+    }
+
+    fclose(file);
+}
@@ -0,0 +1,105 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_OPCODE_STATS
+#define MANGOS_H_OPCODE_STATS
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// Counters for a single opcode, handler times are in microseconds
+struct OpcodeStatEntry
+{
+    OpcodeStatEntry() : calls(0), totalTime(0), maxTime(0), bytesIn(0), sent(0), bytesOut(0) {}
+
+    void Merge(OpcodeStatEntry const& other);
+
+    uint64 calls;                                           ///< handler invocations
+    uint64 totalTime;                                       ///< time spent in the handler
+    uint64 maxTime;                                         ///< longest single handler call
+    uint64 bytesIn;                                         ///< payload received with the opcode
+    uint64 sent;                                            ///< packets sent with the opcode
+    uint64 bytesOut;                                        ///< payload sent with the opcode
+};
+
+typedef std::unordered_map<uint16, OpcodeStatEntry> OpcodeStatMap;
+typedef std::vector<std::pair<uint16, OpcodeStatEntry> > OpcodeStatList;
+
+enum OpcodeStatSortOrder
+{
+    OPCODE_STATS_SORT_TOTAL_TIME    = 0,
+    OPCODE_STATS_SORT_MAX_TIME      = 1,
+    OPCODE_STATS_SORT_CALLS         = 2,
+    OPCODE_STATS_SORT_BYTES_OUT     = 3
+};
+
+/**
+ * Per opcode handler latency and traffic counters.
+ *
+ * Packets are handled one after another on the world thread, which also updates the
+ * maps. Only a few packets are sent from the network threads while a session logs in
+ * (warden init), those record into their own table, all tables are merged when read.
+ */
+class OpcodeStatsMgr
+{
+    public:
+        OpcodeStatsMgr();
+        ~OpcodeStatsMgr();
+
+        void RecordHandler(uint16 opcode, size_t bytes, uint64 time);
+        void RecordSend(uint16 opcode, size_t bytes);
+
+        /// Merge the tables of all threads, sorted by order, at most count entries (0 for all)
+        void GetStats(OpcodeStatList& stats, OpcodeStatSortOrder order, uint32 count = 0) const;
+        void Reset();
+
+        /// Seconds the current counters were collected for
+        uint32 GetCollectTime() const;
+
+        /// Write the merged counters to the snapshot file in the logs directory
+        void WriteSnapshot() const;
+        void SetSnapshotFile(std::string const& file) { m_snapshotFile = file; }
+
+    private:
+        struct ThreadStats
+        {
+            std::mutex lock;                                ///< only contended while the stats are read
+            OpcodeStatMap stats;
+        };
+
+        ThreadStats* GetThreadStats();
+
+        std::vector<ThreadStats*> m_threadStats;
+        mutable std::mutex m_threadStatsLock;
+        time_t m_resetTime;
+        std::string m_snapshotFile;
+};
+
+#define sOpcodeStats MaNGOS::Singleton<OpcodeStatsMgr>::Instance()
+
+#endif
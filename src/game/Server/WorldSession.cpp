@@ -46,6 +46,7 @@
 #include "Auth/AuthCrypt.h"
 #include "Auth/HMACSHA1.h"
 #include "zlib.h"
+#include "OpcodeStats.h"
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #endif /*ENABLE_ELUNA*/
@@ -57,6 +58,7 @@
 #include "WardenWin.h"
 #include "WardenMac.h"
 #include <mutex>
+#include <chrono>
 
 // select opcodes appropriate for processing in Map::Update context for current session state
 static bool MapSessionFilterHelper(WorldSession* session, OpcodeHandler const& opHandle)
@@ -111,7 +113,7 @@ WorldSession::WorldSession(uint32 id, WorldSocket* sock, AccountTypes sec, uint8
     m_muteTime(mute_time), _player(NULL), m_Socket(sock), _security(sec), _accountId(id), m_expansion(expansion), _logoutTime(0),
     m_inQueue(false), m_playerLoading(false), m_playerLogout(false), m_playerRecentlyLogout(false), m_playerSave(false),
     m_sessionDbcLocale(sWorld.GetAvailableDbcLocale(locale)), m_sessionDbLocaleIndex(sObjectMgr.GetIndexForLocale(locale)),
-    m_latency(0), m_clientTimeDelay(0), m_tutorialState(TUTORIALDATA_UNCHANGED)
+    m_latency(0), m_clientTimeDelay(0), m_moveHeartbeatCount(0), m_lastBroadcastMoveFlags(0), m_tutorialState(TUTORIALDATA_UNCHANGED)
 {
     if (sock)
     {
@@ -227,6 +229,11 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
 #endif                                                  // !MANGOS_DEBUG
 
+    if (sWorld.getConfig(CONFIG_BOOL_OPCODE_STATS))
+    {
+        sOpcodeStats.RecordSend(packet->GetOpcode(), packet->wpos());
+    }
+
     if (m_Socket->SendPacket(*packet) == -1)
     {
         m_Socket->CloseSocket();
@@ -590,6 +597,7 @@ void WorldSession::LogoutPlayer(bool Save)
             }
 
             guild->BroadcastEvent(GE_SIGNED_OFF, _player->GetObjectGuid(), _player->GetName());
+            guild->OnMemberLogout(_player);
         }
 
         ///- Remove pet
@@ -1275,7 +1283,17 @@ void WorldSession::ExecuteOpcode(OpcodeHandler const& opHandle, WorldPacket* pac
         _player->SetCanDelayTeleport(true);
     }
 
-    (this->*opHandle.handler)(*packet);
+    if (sWorld.getConfig(CONFIG_BOOL_OPCODE_STATS))
+    {
+        std::chrono::steady_clock::time_point handlerStart = std::chrono::steady_clock::now();
+        (this->*opHandle.handler)(*packet);
+        uint64 handlerTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - handlerStart).count();
+        sOpcodeStats.RecordHandler(packet->GetOpcode(), packet->size(), handlerTime);
+    }
+    else
+    {
+        (this->*opHandle.handler)(*packet);
+    }
 
     if (_player)
     {
@@ -41,6 +41,7 @@
 
 struct ItemPrototype;
 struct AuctionEntry;
+class AuctionHouseObject;
 struct AuctionHouseEntry;
 struct DeclinedName;
 
@@ -411,8 +412,8 @@ class WorldSession
         void SendAuctionRemovedNotification(AuctionEntry* auction);
         static void SendAuctionOutbiddedMail(AuctionEntry* auction);
         void SendAuctionCancelledToBidderMail(AuctionEntry* auction);
-        void BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
-                                   uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull);
+        void BuildListAuctionItems(AuctionHouseObject const* auctionHouse, std::vector<uint32> const& auctions, WorldPacket& data, uint32 listfrom,
+                                   uint32 usable, uint32& count, uint32& totalcount, bool isFull);
 
         AuctionHouseEntry const* GetCheckedAuctionHouseForAuctioneer(ObjectGuid guid);
 
@@ -1019,6 +1020,8 @@ class WorldSession
         int m_sessionDbLocaleIndex;
         uint32 m_latency;
         uint32 m_clientTimeDelay;
+        uint32 m_moveHeartbeatCount;                        // heartbeats broadcast for the current mover, picks which ones distant observers get
+        uint32 m_lastBroadcastMoveFlags;                    // movement flags of the last broadcast movement packet
         AccountData m_accountData[NUM_ACCOUNT_DATA_TYPES];
         uint32 m_Tutorials[8];
         TutorialDataState m_tutorialState;
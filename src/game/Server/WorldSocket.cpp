@@ -109,6 +109,9 @@ WorldSocket::WorldSocket(void) :
     WorldHandler(),
     m_LastPingTime(ACE_Time_Value::zero),
     m_OverSpeedPings(0),
+    m_PacketRateWindowStart(ACE_Time_Value::zero),
+    m_PacketRateCount(0),
+    m_PacketFloodSeconds(0),
     m_Session(0),
     m_RecvWPct(0),
     m_RecvPct(),
@@ -726,6 +729,63 @@ int WorldSocket::schedule_wakeup_output(GuardType& g)
     return 0;
 }
 
+/**
+ * @brief Packets never dropped by the packet rate limit
+ *
+ * Dropping movement, its acks or time sync answers desyncs the client,
+ * dropping logout requests can leave it stuck at the logout screen and
+ * dropping answers the server waits for (warden, ready check, loot roll)
+ * ends in timeouts, a lost warden answer even kicks a legit player.
+ * CMSG_PING and CMSG_AUTH_SESSION are handled before the limit is checked.
+ *
+ * @param opcode
+ * @return bool
+ */
+static bool IsPacketRateLimitExempt(uint16 opcode)
+{
+    // warden is not always in the opcode table, its answer is never dropped anyway
+    if (opcode == CMSG_WARDEN_DATA)
+    {
+        return true;
+    }
+
+    typedef void (WorldSession::*PacketHandler)(WorldPacket& recvPacket);
+    static PacketHandler const exemptHandlers[] =
+    {
+        &WorldSession::HandleMovementOpcodes,
+        &WorldSession::HandleMoveTeleportAckOpcode,
+        &WorldSession::HandleMoveWorldportAckOpcode,
+        &WorldSession::HandleForceSpeedChangeAckOpcodes,
+        &WorldSession::HandleMoveRootAck,
+        &WorldSession::HandleMoveUnRootAck,
+        &WorldSession::HandleMoveKnockBackAck,
+        &WorldSession::HandleMoveHoverAck,
+        &WorldSession::HandleFeatherFallAck,
+        &WorldSession::HandleMoveWaterWalkAck,
+        &WorldSession::HandleMoveSetCanFlyAckOpcode,
+        &WorldSession::HandleMoveSplineDoneOpcode,
+        &WorldSession::HandleSetActiveMoverOpcode,
+        &WorldSession::HandleMoveNotActiveMoverOpcode,
+        &WorldSession::HandleTimeSyncResp,
+        &WorldSession::HandleLogoutRequestOpcode,
+        &WorldSession::HandleLogoutCancelOpcode,
+        &WorldSession::HandleWardenDataOpcode,
+        &WorldSession::HandleRaidReadyCheckOpcode,
+        &WorldSession::HandleLootRoll
+    };
+
+    PacketHandler handler = opcodeTable[opcode].handler;
+    for (size_t i = 0; i < sizeof(exemptHandlers) / sizeof(exemptHandlers[0]); ++i)
+    {
+        if (handler == exemptHandlers[i])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
 {
     MANGOS_ASSERT(new_pct);
@@ -790,6 +850,36 @@ int WorldSocket::ProcessIncoming(WorldPacket* new_pct)
 
                 if (m_Session != NULL)
                 {
+                    // drop packets above the configured rate before they reach the handlers
+                    uint32 maxPackets = sWorld.getConfig(CONFIG_UINT32_MAX_PACKETS_PER_SECOND);
+                    if (maxPackets && m_Session->GetSecurity() == SEC_PLAYER && !IsPacketRateLimitExempt(opcode))
+                    {
+                        ACE_Time_Value cur_time = ACE_OS::gettimeofday();
+                        if (cur_time - m_PacketRateWindowStart >= ACE_Time_Value(1, 0))
+                        {
+                            m_PacketFloodSeconds = m_PacketRateCount > maxPackets ? m_PacketFloodSeconds + 1 : 0;
+                            m_PacketRateWindowStart = cur_time;
+                            m_PacketRateCount = 0;
+                        }
+
+                        if (++m_PacketRateCount > maxPackets)
+                        {
+                            uint32 max_seconds = sWorld.getConfig(CONFIG_UINT32_MAX_PACKET_FLOOD_SECONDS);
+                            if (max_seconds && m_PacketFloodSeconds >= max_seconds)
+                            {
+                                sLog.outError("WorldSocket::ProcessIncoming: Player kicked for "
+                                              "packet flood address = %s",
+                                              GetRemoteAddress().c_str());
+
+                                return -1;
+                            }
+
+                            DEBUG_LOG("WorldSocket::ProcessIncoming: dropped opcode %s (0x%.4X) above packet rate limit from %s",
+                                      LookupOpcodeName(opcode), uint32(opcode), GetRemoteAddress().c_str());
+                            return 0;
+                        }
+                    }
+
                     // OK ,give the packet to WorldSession
                     aptr.release();
                     // WARNING here we call it with locks held.
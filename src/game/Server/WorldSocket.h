@@ -186,6 +186,15 @@ class WorldSocket : protected WorldHandler
         /// Keep track of over-speed pings ,to prevent ping flood.
         uint32 m_OverSpeedPings;
 
+        /// Start of the current one second packet rate window
+        ACE_Time_Value m_PacketRateWindowStart;
+
+        /// Packets received in the current packet rate window
+        uint32 m_PacketRateCount;
+
+        /// Consecutive windows in which the packet rate limit was exceeded, to prevent packet flood.
+        uint32 m_PacketFloodSeconds;
+
         /// Address of the remote peer
         std::string m_Address;
 
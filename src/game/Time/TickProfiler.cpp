@@ -0,0 +1,96 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "TickProfiler.h"
+
+#include <algorithm>
+
+static char const* const worldTickPhaseNames[MAX_WORLD_TICK_PHASES] =
+{
+    "sessions",
+    "maps",
+    "battlegrounds",
+    "outdoorpvp",
+    "result queue",
+    "remove list",
+    "cli commands",
+    "total"
+};
+
+static char const* const mapTickPhaseNames[MAX_MAP_TICK_PHASES] =
+{
+    "sessions",
+    "players",
+    "cells",
+    "active objects",
+    "object updates",
+    "grids",
+    "scripts",
+    "weathers",
+    "total"
+};
+
+char const* GetWorldTickPhaseName(uint32 phase)
+{
+    return phase < MAX_WORLD_TICK_PHASES ? worldTickPhaseNames[phase] : "<unknown>";
+}
+
+char const* GetMapTickPhaseName(uint32 phase)
+{
+    return phase < MAX_MAP_TICK_PHASES ? mapTickPhaseNames[phase] : "<unknown>";
+}
+
+void TickPhaseHistogram::AddSample(uint32 time)
+{
+    _samples[_index] = time;
+
+    if (++_index >= _samples.size())
+    {
+        _index = 0;
+    }
+
+    if (_count < _samples.size())
+    {
+        ++_count;
+    }
+}
+
+void TickPhaseHistogram::GetStats(TickPhaseStats& stats) const
+{
+    stats = TickPhaseStats();
+    if (!_count)
+    {
+        return;
+    }
+
+    // the ring is full once _count reached its size, so the first _count entries are always the samples
+    SampleArray sorted = _samples;
+    std::sort(sorted.begin(), sorted.begin() + _count);
+
+    stats.last = _samples[_index != 0 ? _index - 1 : _samples.size() - 1];
+    stats.p50 = sorted[(_count - 1) / 2];
+    stats.p99 = sorted[(_count - 1) * 99 / 100];
+    stats.max = sorted[_count - 1];
+    stats.samples = _count;
+}
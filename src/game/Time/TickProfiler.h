@@ -0,0 +1,142 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef TICKPROFILER_H
+#define TICKPROFILER_H
+
+#include "Common.h"
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+#define TICK_PROFILE_SAMPLE_COUNT 256
+
+/// Phases of World::Update
+enum WorldTickPhase
+{
+    WORLD_TICK_SESSIONS         = 0,
+    WORLD_TICK_MAPS             = 1,
+    WORLD_TICK_BATTLEGROUNDS    = 2,
+    WORLD_TICK_OUTDOORPVP       = 3,
+    WORLD_TICK_RESULT_QUEUE     = 4,
+    WORLD_TICK_REMOVE_LIST      = 5,
+    WORLD_TICK_CLI_COMMANDS     = 6,
+    WORLD_TICK_TOTAL            = 7,
+    MAX_WORLD_TICK_PHASES       = 8
+};
+
+/// Phases of Map::Update
+enum MapTickPhase
+{
+    MAP_TICK_SESSIONS           = 0,
+    MAP_TICK_PLAYERS            = 1,
+    MAP_TICK_CELLS              = 2,
+    MAP_TICK_ACTIVE_OBJECTS     = 3,
+    MAP_TICK_OBJECT_UPDATES     = 4,
+    MAP_TICK_GRIDS              = 5,
+    MAP_TICK_SCRIPTS            = 6,
+    MAP_TICK_WEATHERS           = 7,
+    MAP_TICK_TOTAL              = 8,
+    MAX_MAP_TICK_PHASES         = 9
+};
+
+char const* GetWorldTickPhaseName(uint32 phase);
+char const* GetMapTickPhaseName(uint32 phase);
+
+/// Rolling statistics of one phase, times are in microseconds
+struct TickPhaseStats
+{
+    TickPhaseStats() : last(0), p50(0), p99(0), max(0), samples(0) {}
+
+    uint32 last;
+    uint32 p50;
+    uint32 p99;
+    uint32 max;                                             ///< longest of the kept samples
+    uint32 samples;
+};
+
+/// Fixed size ring of the last TICK_PROFILE_SAMPLE_COUNT phase times
+class TickPhaseHistogram
+{
+    using SampleArray = std::array<uint32, TICK_PROFILE_SAMPLE_COUNT>;
+
+public:
+    TickPhaseHistogram() : _samples(), _index(0), _count(0) { }
+
+    void AddSample(uint32 time);
+    void GetStats(TickPhaseStats& stats) const;
+
+private:
+    SampleArray _samples;
+    uint32 _index;
+    uint32 _count;
+};
+
+/**
+ * Per phase update times of the world or of one map.
+ *
+ * Maps are updated one after another by the world thread, so a profile is only ever
+ * written and read from the world thread and needs no locking.
+ */
+class TickProfile
+{
+public:
+    explicit TickProfile(uint32 phaseCount) : _phases(phaseCount) { }
+
+    void AddSample(uint32 phase, uint32 time) { _phases[phase].AddSample(time); }
+    void GetStats(uint32 phase, TickPhaseStats& stats) const { _phases[phase].GetStats(stats); }
+    uint32 GetPhaseCount() const { return _phases.size(); }
+
+private:
+    std::vector<TickPhaseHistogram> _phases;
+};
+
+/// Scoped timer adding its lifetime to a phase, does nothing without a profile
+class TickPhaseTimer
+{
+public:
+    TickPhaseTimer(TickProfile* profile, uint32 phase) : _profile(profile), _phase(phase)
+    {
+        if (_profile)
+        {
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~TickPhaseTimer()
+    {
+        if (_profile)
+        {
+            _profile->AddSample(_phase, uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count()));
+        }
+    }
+
+private:
+    TickProfile* _profile;
+    uint32 _phase;
+    std::chrono::steady_clock::time_point _start;
+};
+
+#endif
@@ -486,7 +486,7 @@ void WorldSession::HandleAuctionPlaceBid(WorldPacket& recv_data)
 
     SendAuctionCommandResult(auction, AUCTION_BID_PLACED, AUCTION_OK);
 
-    if (auction->UpdateBid(price, pl))
+    if (auctionHouse->UpdateBid(auction, price, pl))
     {
         pl->GetAchievementMgr().UpdateAchievementCriteria(ACHIEVEMENT_CRITERIA_TYPE_HIGHEST_AUCTION_BID, price);
     }
@@ -715,38 +715,45 @@ void WorldSession::HandleAuctionListItems(WorldPacket& recv_data)
     // always return pointer
     AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(auctionHouseEntry);
 
-    // Sort
-    AuctionHouseObject::AuctionEntryMap const& aucs = auctionHouse->GetAuctions();
-    std::vector<AuctionEntry*> auctions;
-    auctions.reserve(aucs.size());
+    // DEBUG_LOG("Auctionhouse search %s list from: %u, searchedname: %s, levelmin: %u, levelmax: %u, auctionSlotID: %u, auctionMainCategory: %u, auctionSubCategory: %u, quality: %u, usable: %u",
+    //  auctioneerGuid.GetString().c_str(), listfrom, searchedname.c_str(), levelmin, levelmax, auctionSlotID, auctionMainCategory, auctionSubCategory, quality, usable);
+
+    AuctionSearchQuery query;
+    query.locale = GetSessionDbLocaleIndex();
+    memcpy(query.sort, Sort, MAX_AUCTION_SORT);
 
-    for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = aucs.begin(); itr != aucs.end(); ++itr)
+    // full listing ignores all filters
+    if (isFull)
     {
-        auctions.push_back(itr->second);
+        query.levelmin = query.levelmax = 0;
+        query.inventoryType = query.itemClass = query.itemSubClass = query.quality = 0xFFFFFFFF;
     }
+    else
+    {
+        // converting string that we try to find to lower case
+        if (!Utf8toWStr(searchedname, query.name))
+        {
+            return;
+        }
 
-    AuctionSorter sorter(Sort, GetPlayer());
-    std::sort(auctions.begin(), auctions.end(), sorter);
+        wstrToLower(query.name);
 
-    // DEBUG_LOG("Auctionhouse search %s list from: %u, searchedname: %s, levelmin: %u, levelmax: %u, auctionSlotID: %u, auctionMainCategory: %u, auctionSubCategory: %u, quality: %u, usable: %u",
-    //  auctioneerGuid.GetString().c_str(), listfrom, searchedname.c_str(), levelmin, levelmax, auctionSlotID, auctionMainCategory, auctionSubCategory, quality, usable);
+        query.levelmin = levelmin;
+        query.levelmax = levelmax;
+        query.inventoryType = auctionSlotID;
+        query.itemClass = auctionMainCategory;
+        query.itemSubClass = auctionSubCategory;
+        query.quality = quality;
+    }
+
+    AuctionIdList const& auctions = auctionHouse->SearchAuctions(query, GetPlayer());
 
     WorldPacket data(SMSG_AUCTION_LIST_RESULT, (4 + 4 + 4));
     uint32 count = 0;
     uint32 totalcount = 0;
     data << uint32(0);
 
-    // converting string that we try to find to lower case
-    std::wstring wsearchedname;
-    if (!Utf8toWStr(searchedname, wsearchedname))
-    {
-        return;
-    }
-
-    wstrToLower(wsearchedname);
-
-    BuildListAuctionItems(auctions, data, wsearchedname, listfrom, levelmin, levelmax, usable,
-                          auctionSlotID, auctionMainCategory, auctionSubCategory, quality, count, totalcount, isFull);
+    BuildListAuctionItems(auctionHouse, auctions, data, listfrom, usable, count, totalcount, isFull);
 
     data.put<uint32>(0, count);
     data << uint32(totalcount);
@@ -741,7 +741,7 @@ bool GridMap::ExistVMap(uint32 mapid, int gx, int gy)
 }
 
 //////////////////////////////////////////////////////////////////////////
-TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
+TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid), m_vmapGeneration(0)
 {
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
     {
@@ -833,6 +833,7 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
 
                 // unload VMAPS...
                 VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId, x, y);
+                ++m_vmapGeneration;
 
                 // unload mmap...
                 MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId, x, y);
@@ -843,6 +844,33 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
     i_timer.Reset();
 }
 
+uint32 TerrainInfo::Preload()
+{
+    uint32 count = 0;
+    std::string mapFileFormat = sWorld.GetDataPath() + "maps/%04u%02u%02u.map";
+    for (uint32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+    {
+        for (uint32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+        {
+            char fileName[1024];
+            snprintf(fileName, sizeof(fileName), mapFileFormat.c_str(), m_mapId, x, y);
+
+            // most grids of a map do not exist, check quietly instead of GridMap::ExistMap
+            FILE* pf = fopen(fileName, "rb");
+            if (!pf)
+            {
+                continue;
+            }
+            fclose(pf);
+
+            Load(x, y);
+            ++count;
+        }
+    }
+
+    return count;
+}
+
 int TerrainInfo::RefGrid(const uint32& x, const uint32& y)
 {
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
@@ -1321,6 +1349,7 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
             switch (vmapLoadResult)
             {
                 case VMAP::VMAP_LOAD_RESULT_OK:
+                    ++m_vmapGeneration;
                     DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "VMAP loaded name:%s, id:%d, x:%d, y:%d (vmap rep.: x:%d, y:%d)", mapName, m_mapId, x, y, x, y);
                     break;
                 case VMAP::VMAP_LOAD_RESULT_ERROR:
@@ -1423,6 +1452,26 @@ void TerrainManager::UnloadTerrain(const uint32 mapId)
     }
 }
 
+void TerrainManager::PreloadTerrain(const char* mapIds)
+{
+    std::string mapList = mapIds;
+    for (char* idstr = strtok(&mapList[0], ","); idstr; idstr = strtok(NULL, ","))
+    {
+        uint32 mapId = uint32(atoi(idstr));
+        if (!sMapStore.LookupEntry(mapId))
+        {
+            sLog.outError("Instance.PreloadMaps: map %u does not exist, skipped.", mapId);
+            continue;
+        }
+
+        // never released, so neither the terrain nor its grids get unloaded
+        TerrainInfo* terrain = LoadTerrain(mapId);
+        terrain->AddRef();
+        uint32 count = terrain->Preload();
+        sLog.outString("Preloaded %u grids of map %u", count, mapId);
+    }
+}
+
 void TerrainManager::Update(const uint32 diff)
 {
     // global garbage collection for GridMap objects and VMaps
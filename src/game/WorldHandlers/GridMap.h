@@ -32,6 +32,7 @@
 #include "Object.h"
 #include "SharedDefines.h"
 
+#include <atomic>
 #include <bitset>
 #include <list>
 
@@ -229,6 +230,8 @@ class TerrainInfo : public Referencable<AtomicLong>
         ~TerrainInfo();
 
         uint32 GetMapId() const { return m_mapId; }
+        // changed on every vmap tile load/unload, line of sight results cached before are outdated
+        uint32 GetVMapGeneration() const { return m_vmapGeneration; }
 
         // TODO: move all terrain/vmaps data info query functions
         // from 'Map' class into this class
@@ -258,6 +261,9 @@ class TerrainInfo : public Referencable<AtomicLong>
         // THIS METHOD IS NOT THREAD-SAFE!!!! AND IT SHOULDN'T BE THREAD-SAFE!!!!
         void CleanUpGrids(const uint32 diff);
 
+        // load and reference every grid of the map which has a map file, they stay loaded for good
+        uint32 Preload();
+
     protected:
         friend class Map;
         // load/unload terrain data
@@ -282,6 +288,8 @@ class TerrainInfo : public Referencable<AtomicLong>
         // global garbage collection timer
         IntervalTimer i_timer;
 
+        std::atomic<uint32> m_vmapGeneration;
+
         typedef ACE_Thread_Mutex LOCK_TYPE;
         typedef ACE_Guard<LOCK_TYPE> LOCK_GUARD;
         LOCK_TYPE m_mutex;
@@ -297,6 +305,8 @@ class TerrainManager : public MaNGOS::Singleton<TerrainManager, MaNGOS::ClassLev
     public:
         TerrainInfo* LoadTerrain(const uint32 mapId);
         void UnloadTerrain(const uint32 mapId);
+        // keep the terrain of the maps in the list (map ids with delimiter ',') loaded for the whole uptime
+        void PreloadTerrain(const char* mapIds);
 
         void Update(const uint32 diff);
         void UnloadAll();
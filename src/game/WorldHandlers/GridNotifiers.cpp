@@ -25,6 +25,7 @@
 #include "GridNotifiers.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
+#include "World.h"
 #include "UpdateData.h"
 #include "Item.h"
 #include "Map.h"
@@ -147,6 +148,53 @@ void MessageDelivererExcept::Visit(CameraMapType& m)
     }
 }
 
+MovementMessageDeliverer::MovementMessageDeliverer(WorldObject const* mover, WorldPacket* msg, Player const* skipped, uint32 heartbeat)
+    : i_mover(mover), i_message(msg), i_skipped_receiver(skipped), i_heartbeat(heartbeat)
+{
+    float fullRateDist = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_BROADCAST_FULL_RATE_DISTANCE);
+    float halfRateDist = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_BROADCAST_HALF_RATE_DISTANCE);
+
+    if (fullRateDist <= 0.0f)
+    {
+        i_heartbeat = 0;
+    }
+
+    i_fullRateDistSq = fullRateDist * fullRateDist;
+    i_halfRateDistSq = halfRateDist * halfRateDist;
+}
+
+void MovementMessageDeliverer::Visit(CameraMapType& m)
+{
+    for (CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Player* owner = iter->getSource()->GetOwner();
+
+        if (!owner->InSamePhase(i_mover) || owner == i_skipped_receiver)
+        {
+            continue;
+        }
+
+        if (i_heartbeat)
+        {
+            WorldObject const* body = iter->getSource()->GetBody();
+            float dx = body->GetPositionX() - i_mover->GetPositionX();
+            float dy = body->GetPositionY() - i_mover->GetPositionY();
+            float dz = body->GetPositionZ() - i_mover->GetPositionZ();
+            float distSq = dx * dx + dy * dy + dz * dz;
+
+            if (distSq > i_fullRateDistSq && i_heartbeat % (distSq > i_halfRateDistSq ? 4 : 2))
+            {
+                continue;
+            }
+        }
+
+        if (WorldSession* session = owner->GetSession())
+        {
+            session->SendPacket(i_message);
+        }
+    }
+}
+
 void ObjectMessageDeliverer::Visit(CameraMapType& m)
 {
     for (CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -83,6 +83,22 @@ namespace MaNGOS
         template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
     };
 
+    // delivers movement of mover, plain heartbeats are thinned out for distant observers
+    struct MovementMessageDeliverer
+    {
+        WorldObject const* i_mover;
+        WorldPacket*  i_message;
+        Player const* i_skipped_receiver;
+        uint32        i_heartbeat;                      // 0 for packets which every observer must get
+        float         i_fullRateDistSq;                 // observers closer than this get every heartbeat
+        float         i_halfRateDistSq;                 // observers closer than this get every second heartbeat
+
+        MovementMessageDeliverer(WorldObject const* mover, WorldPacket* msg, Player const* skipped, uint32 heartbeat);
+
+        void Visit(CameraMapType& m);
+        template<class SKIP> void Visit(GridRefManager<SKIP>&) {}
+    };
+
     struct ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
@@ -51,6 +51,8 @@ LFGMgr::~LFGMgr()
 
     m_playerData.clear();
     m_queueSet.clear();
+    m_queueEntries.clear();
+    m_queueBuckets.clear();
 
     m_playerStatusMap.clear();
     m_groupStatusMap.clear();
@@ -173,11 +175,7 @@ void LFGMgr::JoinLFG(uint32 roles, std::set<uint32> dungeons, std::string commen
         if (currentInfo->currentState == LFG_STATE_QUEUED)
         {
             // remove from that queue so they can later join this one
-            queueSet::iterator qItr = m_queueSet.find(guid);
-            if (qItr != m_queueSet.end())
-            {
-                m_queueSet.erase(qItr);
-            }
+            RemoveFromQueue(guid);
             // note: do we need to send a packet telling them the current queue is over?
         }
 
@@ -438,7 +436,7 @@ void LFGMgr::LeaveLFG(Player* plr, bool isGroup)
             }
         }
 
-        m_queueSet.erase(grpGuid);
+        RemoveFromQueue(grpGuid);
         m_playerData.erase(grpGuid);
     }
     else
@@ -457,7 +455,7 @@ void LFGMgr::LeaveLFG(Player* plr, bool isGroup)
             // do other states after being implemented, if applicable for a single plr
         }
 
-        m_queueSet.erase(plrGuid);
+        RemoveFromQueue(plrGuid);
         m_playerData.erase(plrGuid);
         m_playerStatusMap.erase(plrGuid);
     }
@@ -867,8 +865,8 @@ void LFGMgr::UpdateNeededRoles(ObjectGuid guid, LFGPlayers* information)
     LfgDungeonsEntry const* dungeon = sLfgDungeonsStore.LookupEntry(*itr);
     if (dungeon)
     {
-        // atm we're just handling DUNGEON_DIFFICULTY_NORMAL
-        if (dungeon->difficulty == DUNGEON_DIFFICULTY_NORMAL)
+        // atm we're just handling 5 man dungeons, heroic ones need the same roles as normal ones
+        if (dungeon->difficulty == DUNGEON_DIFFICULTY_NORMAL || dungeon->difficulty == DUNGEON_DIFFICULTY_HEROIC)
         {
             information->neededTanks = NORMAL_TANK_OR_HEALER_COUNT - tankCount;
             information->neededHealers = NORMAL_TANK_OR_HEALER_COUNT - healCount;
@@ -896,11 +894,51 @@ void LFGMgr::AddToQueue(ObjectGuid guid)
         AddToWaitMap(it->second, information->dungeonList);
     }
 
-    // just in case someone's already been in the queue.
-    queueSet::iterator qItr = m_queueSet.find(guid);
-    if (qItr == m_queueSet.end())
+    // just in case someone's already been in the queue, their roles or dungeons may have changed
+    RemoveFromQueue(guid);
+    m_queueSet.insert(guid);
+
+    LFGQueueEntry& entry = m_queueEntries[guid];
+    entry.dungeonList = information->dungeonList;
+    entry.players = information->currentRoles.size();
+
+    // players who picked several roles get one of them assigned when a group is formed
+    for (roleMap::iterator it = information->currentRoles.begin(); it != information->currentRoles.end(); ++it)
     {
-        m_queueSet.insert(guid);
+        uint8 roles = it->second & (PLAYER_ROLE_TANK | PLAYER_ROLE_HEALER | PLAYER_ROLE_DAMAGE);
+        entry.roles.push_back(std::make_pair(it->first, roles));
+
+        if (roles & PLAYER_ROLE_TANK)
+        {
+            ++entry.tanks;
+        }
+        if (roles & PLAYER_ROLE_HEALER)
+        {
+            ++entry.healers;
+        }
+        if (roles & PLAYER_ROLE_DAMAGE)
+        {
+            ++entry.dps;
+        }
+    }
+
+    for (roleMap::iterator it = information->currentRoles.begin(); it != information->currentRoles.end(); ++it)
+    {
+        if (Player* pPlayer = sObjectAccessor.FindPlayer(it->first))
+        {
+            entry.team = pPlayer->GetTeam();
+            break;
+        }
+    }
+
+    for (std::set<uint32>::iterator itr = entry.dungeonList.begin(); itr != entry.dungeonList.end(); ++itr)
+    {
+        LFGQueueBucket& bucket = m_queueBuckets[std::make_pair(*itr, entry.team)];
+        bucket.entries.push_back(guid);
+        bucket.tanks += entry.tanks;
+        bucket.healers += entry.healers;
+        bucket.dps += entry.dps;
+        bucket.players += entry.players;
     }
 }
 
@@ -908,6 +946,36 @@ void LFGMgr::RemoveFromQueue(ObjectGuid guid)
 {
     m_queueSet.erase(guid);
 
+    queueEntryMap::iterator entryItr = m_queueEntries.find(guid);
+    if (entryItr == m_queueEntries.end())
+    {
+        return;
+    }
+
+    // empty buckets are kept, there is at most one per dungeon and team
+    LFGQueueEntry const& entry = entryItr->second;
+    for (std::set<uint32>::const_iterator itr = entry.dungeonList.begin(); itr != entry.dungeonList.end(); ++itr)
+    {
+        queueBucketMap::iterator bucketItr = m_queueBuckets.find(std::make_pair(*itr, entry.team));
+        if (bucketItr == m_queueBuckets.end())
+        {
+            continue;
+        }
+
+        LFGQueueBucket& bucket = bucketItr->second;
+        std::vector<ObjectGuid>::iterator guidItr = std::find(bucket.entries.begin(), bucket.entries.end(), guid);
+        if (guidItr != bucket.entries.end())
+        {
+            bucket.entries.erase(guidItr);
+            bucket.tanks -= entry.tanks;
+            bucket.healers -= entry.healers;
+            bucket.dps -= entry.dps;
+            bucket.players -= entry.players;
+        }
+    }
+
+    m_queueEntries.erase(entryItr);
+
     //todo - might need to implement a removefromwaitmap function
 }
 
@@ -992,111 +1060,169 @@ void LFGMgr::AddToWaitMap(uint8 role, std::set<uint32> dungeons)
 
 void LFGMgr::FindQueueMatches()
 {
-    // Fetch information on all the queued players/groups
-    for (queueSet::iterator itr = m_queueSet.begin(); itr != m_queueSet.end(); ++itr)
+    // forming a group removes its members from every bucket they are in, buckets themselves are never erased
+    for (queueBucketMap::iterator itr = m_queueBuckets.begin(); itr != m_queueBuckets.end(); ++itr)
     {
-        FindSpecificQueueMatches(*itr);
-    }
-}
+        LFGQueueBucket const& bucket = itr->second;
 
-void LFGMgr::FindSpecificQueueMatches(ObjectGuid guid)
-{
-    uint64 rawGuid = guid.GetRawValue();
-    LFGPlayers* queueInfo = GetPlayerOrPartyData(guid);
-    if (queueInfo)
-    {
-        // compare to everyone else in queue for compatibility
-        // after a match is found call UpdateNeededRoles
-        // Use the roleMap to store player guid/role information; merge into queueInfo struct & delete other struct/map entry
-        for (queueSet::iterator itr = m_queueSet.begin(); itr != m_queueSet.end(); ++itr)
+        // the counters tell without looking at the entries whether there are enough players for each role at all
+        // an entry which can not be completed right now must not hold back the ones behind it
+        size_t first = 0;
+        while (first < bucket.entries.size() && bucket.players >= NORMAL_TOTAL_ROLE_COUNT &&
+               bucket.tanks >= NORMAL_TANK_OR_HEALER_COUNT && bucket.healers >= NORMAL_TANK_OR_HEALER_COUNT && bucket.dps >= NORMAL_DAMAGE_COUNT)
         {
-            if (*itr == guid)
+            if (FormGroupFromBucket(itr->first.first, bucket, first))
             {
-                continue;
+                first = 0;
             }
-
-            LFGPlayers* matchInfo = GetPlayerOrPartyData(*itr);
-            if (matchInfo)
+            else
             {
-                // 1. iterate through queueInfo's dungeon set and search the matchInfo for a matching entry.
-                // 2. if an(y) entry is found, great and proceed!
-                // 2a. if an entry is found and the amounts of players-to-roles are compatible, make
-                //     a new map of only the inter-compatible dungeons and use that if the other checks pass
-                // 3. Regardless of outcome, after the end of calculations send a LFGQueueStatus packet
-                bool fullyCompatible = false;
-                std::set<uint32> compatibleDungeons;
-
-                for (std::set<uint32>::iterator dItr = matchInfo->dungeonList.begin(); dItr != matchInfo->dungeonList.end(); ++itr)
-                {
-                    if (queueInfo->dungeonList.find(*dItr) != queueInfo->dungeonList.end())
-                    {
-                        compatibleDungeons.insert(*dItr);
-                    }
-                }
-
-                if (!compatibleDungeons.empty())
-                {
-                    // check for player / role count and also team compatibility
-                    // if function returns true, then merge groups into one
-                    if (RoleMapsAreCompatible(queueInfo, matchInfo) && MatchesAreOfSameTeam(queueInfo, matchInfo))
-                    {
-                        MergeGroups(guid, *itr, compatibleDungeons);
-                    }
-                }
+                ++first;
             }
         }
     }
 }
 
-bool LFGMgr::RoleMapsAreCompatible(LFGPlayers* groupOne, LFGPlayers* groupTwo)
+/// Assign one of its roles to every player from index on, at most a group's worth of each role
+static bool AssignQueueRoles(std::vector<uint8> const& roleMasks, size_t index, uint8 freeTanks, uint8 freeHealers, uint8 freeDps, std::vector<uint8>& assigned)
 {
-    // When this is called we already know that the dungeons match, so just focus on roles
-    // compare: neededX(role) from each struct and the amount of people per role in the roleMap
-    if ((groupOne->currentRoles.size() + groupTwo->currentRoles.size()) > NORMAL_TOTAL_ROLE_COUNT)
+    if (index == roleMasks.size())
     {
-        return false;
+        return true;
     }
-    else
+
+    uint8 roles = roleMasks[index];
+    if ((roles & PLAYER_ROLE_TANK) && freeTanks)
     {
-        // make sure we don't have too many players of a certain role here
-        if (((NORMAL_DAMAGE_COUNT - groupOne->neededDps) + (NORMAL_DAMAGE_COUNT - groupTwo->neededDps)) > NORMAL_DAMAGE_COUNT)
-        {
-            return false;
-        }
-        else if (((NORMAL_TANK_OR_HEALER_COUNT - groupOne->neededHealers) + (NORMAL_TANK_OR_HEALER_COUNT - groupTwo->neededHealers)) > NORMAL_TANK_OR_HEALER_COUNT)
+        assigned[index] = PLAYER_ROLE_TANK;
+        if (AssignQueueRoles(roleMasks, index + 1, freeTanks - 1, freeHealers, freeDps, assigned))
         {
-            return false;
+            return true;
         }
-        else if (((NORMAL_TANK_OR_HEALER_COUNT - groupOne->neededTanks) + (NORMAL_TANK_OR_HEALER_COUNT - groupTwo->neededTanks)) > NORMAL_TANK_OR_HEALER_COUNT)
+    }
+
+    if ((roles & PLAYER_ROLE_HEALER) && freeHealers)
+    {
+        assigned[index] = PLAYER_ROLE_HEALER;
+        if (AssignQueueRoles(roleMasks, index + 1, freeTanks, freeHealers - 1, freeDps, assigned))
         {
-            return false;
+            return true;
         }
-        else
+    }
+
+    if ((roles & PLAYER_ROLE_DAMAGE) && freeDps)
+    {
+        assigned[index] = PLAYER_ROLE_DAMAGE;
+        if (AssignQueueRoles(roleMasks, index + 1, freeTanks, freeHealers, freeDps - 1, assigned))
         {
-            return true; // the player/role counts line up!
+            return true;
         }
     }
+
     return false;
 }
 
-bool LFGMgr::MatchesAreOfSameTeam(LFGPlayers* groupOne, LFGPlayers* groupTwo)
+bool LFGMgr::FormGroupFromBucket(uint32 dungeonId, LFGQueueBucket const& bucket, size_t first)
 {
-    // we should safely be able to compare any two players from each struct to
-    // determine compatibility
-    roleMap::iterator it1 = groupOne->currentRoles.begin();
-    roleMap::iterator it2 = groupTwo->currentRoles.begin();
+    std::vector<ObjectGuid> members;
+    std::vector<uint8> roleMasks;                           // of every player of the members, in member order
+    std::vector<uint8> assigned;
 
-    // now we find the players from the maps
-    Player* pPlayer1 = sObjectAccessor.FindPlayer(it1->first);
-    Player* pPlayer2 = sObjectAccessor.FindPlayer(it2->first);
+    // the entry at first is taken first, then the others in join order
+    for (size_t i = 0; i < bucket.entries.size() && roleMasks.size() < NORMAL_TOTAL_ROLE_COUNT; ++i)
+    {
+        ObjectGuid guid = bucket.entries[i == 0 ? first : (i <= first ? i - 1 : i)];
+        LFGQueueEntry const& entry = m_queueEntries[guid];
+        if (entry.roles.empty() || roleMasks.size() + entry.roles.size() > NORMAL_TOTAL_ROLE_COUNT)
+        {
+            continue;
+        }
+
+        size_t oldSize = roleMasks.size();
+        for (std::vector<std::pair<ObjectGuid, uint8> >::const_iterator itr = entry.roles.begin(); itr != entry.roles.end(); ++itr)
+        {
+            roleMasks.push_back(itr->second);
+        }
+
+        assigned.resize(roleMasks.size());
+        if (!AssignQueueRoles(roleMasks, 0, NORMAL_TANK_OR_HEALER_COUNT, NORMAL_TANK_OR_HEALER_COUNT, NORMAL_DAMAGE_COUNT, assigned))
+        {
+            // the entry the group is built around does not fit on its own
+            if (i == 0)
+            {
+                return false;
+            }
+
+            roleMasks.resize(oldSize);
+            continue;
+        }
 
-    // todo: disable this if a config option is set
-    if (pPlayer1->GetTeamId() == pPlayer2->GetTeamId())
+        members.push_back(guid);
+    }
+
+    // five players whose roles can be assigned are exactly one tank, one healer and three dps
+    if (roleMasks.size() != NORMAL_TOTAL_ROLE_COUNT)
     {
-        return true;
+        return false;
     }
 
-    return false;
+    assigned.resize(roleMasks.size());
+    AssignQueueRoles(roleMasks, 0, NORMAL_TANK_OR_HEALER_COUNT, NORMAL_TANK_OR_HEALER_COUNT, NORMAL_DAMAGE_COUNT, assigned);
+
+    // the assigned roles replace the choices, so the needed role counts of the merged group come out as zero
+    size_t roleIndex = 0;
+    for (std::vector<ObjectGuid>::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    {
+        LFGQueueEntry const& entry = m_queueEntries[*itr];
+        LFGPlayers* information = GetPlayerOrPartyData(*itr);
+        for (std::vector<std::pair<ObjectGuid, uint8> >::const_iterator rItr = entry.roles.begin(); rItr != entry.roles.end(); ++rItr, ++roleIndex)
+        {
+            if (information)
+            {
+                uint8& role = information->currentRoles[rItr->first];
+                role = (role & PLAYER_ROLE_LEADER) | assigned[roleIndex];
+            }
+        }
+    }
+
+    // members leave the queue first, the bucket is not touched while merging
+    for (std::vector<ObjectGuid>::const_iterator itr = members.begin(); itr != members.end(); ++itr)
+    {
+        RemoveFromQueue(*itr);
+    }
+
+    std::set<uint32> dungeon;
+    dungeon.insert(dungeonId);
+
+    // merge everyone into the longest waiting entry, the last merge sends the proposal
+    ObjectGuid mainGuid = members.front();
+    if (members.size() == 1)
+    {
+        if (LFGPlayers* mainGroup = GetPlayerOrPartyData(mainGuid))
+        {
+            mainGroup->dungeonList = dungeon;
+            UpdateNeededRoles(mainGuid, mainGroup);
+            SendDungeonProposal(mainGroup);
+        }
+    }
+
+    for (std::vector<ObjectGuid>::const_iterator itr = members.begin() + 1; itr != members.end(); ++itr)
+    {
+        MergeGroups(mainGuid, *itr, dungeon);
+    }
+
+    return true;
+}
+
+void LFGMgr::GetQueueStats(std::vector<std::pair<std::pair<uint32, uint32>, LFGQueueBucket const*> >& stats) const
+{
+    for (queueBucketMap::const_iterator itr = m_queueBuckets.begin(); itr != m_queueBuckets.end(); ++itr)
+    {
+        if (!itr->second.entries.empty())
+        {
+            stats.push_back(std::make_pair(itr->first, &itr->second));
+        }
+    }
 }
 
 void LFGMgr::MergeGroups(ObjectGuid guidOne, ObjectGuid guidTwo, std::set<uint32> compatibleDungeons)
@@ -28,6 +28,7 @@
 #include "Common.h"
 #include "Policies/Singleton.h"
 #include "Group.h"
+#include <map>
 #include <set>
 #include <vector>
 
@@ -41,6 +42,8 @@ struct LFGGroupStatus;
 struct LFGPlayers;
 struct LFGPlayerStatus;
 struct LFGProposal;
+struct LFGQueueBucket;
+struct LFGQueueEntry;
 struct LFGRoleCheck;
 struct LFGWait;
 
@@ -250,6 +253,8 @@ typedef std::unordered_map<ObjectGuid, LFGProposalAnswer> proposalAnswerMap;  //
 typedef std::unordered_map<ObjectGuid, ObjectGuid> playerGroupMap;            // ObjectGuid of player, ObjectGuid of group
 typedef std::unordered_map<ObjectGuid, LFGGroupStatus> groupStatusMap;        // ObjectGuid of group, group status structure
 typedef std::unordered_map<ObjectGuid, LFGBoot> bootStatusMap;                // ObjectGuid of group, boot vote status
+typedef std::unordered_map<ObjectGuid, LFGQueueEntry> queueEntryMap;          // ObjectGuid of plr/group, what they bring to the matchmaker
+typedef std::map<std::pair<uint32, uint32>, LFGQueueBucket> queueBucketMap;   // (DungeonID, team), entries queued for that dungeon
 
 // End Section: Constants & Definitions
 
@@ -286,6 +291,32 @@ struct LFGPlayers //TODO: rename to LFGQueueData
         neededHealers(NeededHealers), neededDps(NeededDps) {}
 };
 
+/// Snapshot of a queued player or group, taken when they enter the queue
+struct LFGQueueEntry
+{
+    uint32 team;                  // Team of the players, only the same team is grouped
+    std::set<uint32> dungeonList; // every bucket the entry is in
+    std::vector<std::pair<ObjectGuid, uint8> > roles; // every player with the roles they are willing to take, leader flag stripped
+    uint8 tanks;                  // players willing to take the role, one player may count for several roles
+    uint8 healers;
+    uint8 dps;
+    uint8 players;                // amount of players
+
+    LFGQueueEntry() : team(0), tanks(0), healers(0), dps(0), players(0) {}
+};
+
+/// Everyone queued for one dungeon on one team
+struct LFGQueueBucket
+{
+    std::vector<ObjectGuid> entries; // in join order, so the longest waiting get grouped first
+    uint32 tanks;                    // players of all entries willing to take the role
+    uint32 healers;
+    uint32 dps;
+    uint32 players;
+
+    LFGQueueBucket() : tanks(0), healers(0), dps(0), players(0) {}
+};
+
 struct LFGRoleCheck
 {
     LFGRoleCheckState state;      // current status of the role check
@@ -555,15 +586,27 @@ public:
      */
     void RemoveFromQueue(ObjectGuid guid);
 
-    /// Search the queue for compatible matches
+    /// Form groups out of every queue bucket that has enough roles
     void FindQueueMatches();
 
     /**
-     * @brief Search the queue for matches based off of one's guid
+     * @brief Greedily pick entries of a bucket, oldest first, until a full group is found
      *
-     * @param guid The player or group's guid
+     * An entry is only taken if the roles of everyone picked so far can still be assigned,
+     * the assigned roles replace the role choices of the players of the formed group.
+     *
+     * @param dungeonId The dungeon the bucket is queued for
+     * @param bucket The bucket to form the group from
+     * @param first Index of the entry the group is built around, the others are picked oldest first
+     * @return true if a group was formed and sent a proposal
      */
-    void FindSpecificQueueMatches(ObjectGuid guid);
+    bool FormGroupFromBucket(uint32 dungeonId, LFGQueueBucket const& bucket, size_t first);
+
+    /// Queue depth of every (dungeon, team) bucket that has someone in it
+    void GetQueueStats(std::vector<std::pair<std::pair<uint32, uint32>, LFGQueueBucket const*> >& stats) const;
+
+    /// Amount of players and groups in the queue
+    uint32 GetQueuedCount() const { return m_queueSet.size(); }
 
     /// Send a periodic status update for queued players
     void SendQueueStatus();
@@ -613,12 +656,6 @@ protected:
     /// Checks if any players have the leader flag for their roles
     bool HasLeaderFlag(roleMap const& roles);
 
-    /// Compares two groups/players to see if their role combinations are compatible
-    bool RoleMapsAreCompatible(LFGPlayers* groupOne, LFGPlayers* groupTwo);
-
-    /// Checks whether or not two combinations of players/groups are on the same team (alliance/horde)
-    bool MatchesAreOfSameTeam(LFGPlayers* groupOne, LFGPlayers* groupTwo);
-
     /// Are the players in a proposal already grouped up?
     bool IsProposalSameGroup(LFGProposal const& proposal);
 
@@ -672,6 +709,10 @@ private:
     playerData m_playerData;
     queueSet   m_queueSet;
 
+    /// Matchmaker buckets, every queued entry is in the bucket of each of its dungeons
+    queueEntryMap  m_queueEntries;
+    queueBucketMap m_queueBuckets;
+
     /// Dungeon Finder Status for players
     playerStatusMap m_playerStatusMap;
 
@@ -0,0 +1,88 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "LineOfSightCache.h"
+
+#include <cmath>
+
+#define LOS_CACHE_GRID_SIZE 0.25f                           // positions closer than this share the result
+
+LineOfSightCache::LineOfSightCache(uint32 size) : m_entries(size), m_generation(1), m_hits(0), m_misses(0)
+{
+    for (std::vector<LineOfSightEntry>::iterator itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+    {
+        itr->generation = 0;
+    }
+}
+
+void LineOfSightCache::MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightKey& key)
+{
+    key.src[0] = int32(std::floor(x1 / LOS_CACHE_GRID_SIZE));
+    key.src[1] = int32(std::floor(y1 / LOS_CACHE_GRID_SIZE));
+    key.src[2] = int32(std::floor(z1 / LOS_CACHE_GRID_SIZE));
+    key.dest[0] = int32(std::floor(x2 / LOS_CACHE_GRID_SIZE));
+    key.dest[1] = int32(std::floor(y2 / LOS_CACHE_GRID_SIZE));
+    key.dest[2] = int32(std::floor(z2 / LOS_CACHE_GRID_SIZE));
+    key.phasemask = phasemask;
+}
+
+LineOfSightCache::LineOfSightEntry& LineOfSightCache::GetSlot(LineOfSightKey const& key)
+{
+    uint32 hash = key.phasemask;
+    for (int i = 0; i < 3; ++i)
+    {
+        hash = hash * 31 + uint32(key.src[i]);
+        hash = hash * 31 + uint32(key.dest[i]);
+    }
+
+    return m_entries[hash % m_entries.size()];
+}
+
+bool LineOfSightCache::Find(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool& inLineOfSight)
+{
+    LineOfSightKey key;
+    MakeKey(x1, y1, z1, x2, y2, z2, phasemask, key);
+
+    LineOfSightEntry const& entry = GetSlot(key);
+    if (entry.generation != m_generation || !(entry.key == key))
+    {
+        ++m_misses;
+        return false;
+    }
+
+    ++m_hits;
+    inLineOfSight = entry.inLineOfSight;
+    return true;
+}
+
+void LineOfSightCache::Insert(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool inLineOfSight)
+{
+    LineOfSightKey key;
+    MakeKey(x1, y1, z1, x2, y2, z2, phasemask, key);
+
+    LineOfSightEntry& entry = GetSlot(key);
+    entry.key = key;
+    entry.generation = m_generation;
+    entry.inLineOfSight = inLineOfSight;
+}
@@ -0,0 +1,85 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_LINEOFSIGHTCACHE
+#define MANGOS_H_LINEOFSIGHTCACHE
+
+#include "Common.h"
+
+/**
+ * Results of recent line of sight checks of a map instance, combined static and dynamic vmaps.
+ * Start and end positions are quantized, so the same caster/target pair checked by the AI,
+ * the spell cast and the spell hit shares one trace. Direct mapped, a new result replaces
+ * whatever was stored in its slot. Must be invalidated whenever a dynamic model changes.
+ * Not threadsafe, every map instance uses its own cache.
+ */
+class LineOfSightCache
+{
+    public:
+        explicit LineOfSightCache(uint32 size);
+
+        // return false if the ray was not traced since the last invalidation
+        bool Find(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool& inLineOfSight);
+        void Insert(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, bool inLineOfSight);
+
+        // door opened, gameobject spawned/despawned...
+        void Invalidate() { ++m_generation; }
+
+        uint32 GetSize() const { return m_entries.size(); }
+        uint32 GetHits() const { return m_hits; }
+        uint32 GetMisses() const { return m_misses; }
+        uint32 GetInvalidations() const { return m_generation - 1; }
+
+    private:
+        struct LineOfSightKey
+        {
+            int32 src[3];
+            int32 dest[3];
+            uint32 phasemask;
+
+            bool operator==(LineOfSightKey const& other) const
+            {
+                return src[0] == other.src[0] && src[1] == other.src[1] && src[2] == other.src[2] &&
+                       dest[0] == other.dest[0] && dest[1] == other.dest[1] && dest[2] == other.dest[2] &&
+                       phasemask == other.phasemask;
+            }
+        };
+
+        struct LineOfSightEntry
+        {
+            LineOfSightKey key;
+            uint32 generation;                              // 0 for a never used slot
+            bool inLineOfSight;
+        };
+
+        static void MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightKey& key);
+        LineOfSightEntry& GetSlot(LineOfSightKey const& key);
+
+        std::vector<LineOfSightEntry> m_entries;
+        uint32 m_generation;
+        uint32 m_hits;
+        uint32 m_misses;
+};
+
+#endif
@@ -675,6 +675,9 @@ void WorldSession::HandleGetMailList(WorldPacket& recv_data)
         return;
     }
 
+    // first mailbox use in this session, only the mail index was loaded at login
+    _player->LoadMails();
+
     // client can't work with packets > max int16 value
     const uint32 maxPacketSize = 32767;
 
@@ -864,6 +867,44 @@ void WorldSession::HandleMailCreateTextItem(WorldPacket& recv_data)
     }
 }
 
+/**
+ * Appends one unread mail to MSG_QUERY_NEXT_MAIL_TIME, shared by the loaded mailbox and the login mail index
+ *
+ * @return true, if the mail is listed (not read yet and already delivered)
+ */
+static bool AppendNextMailTimeEntry(WorldPacket& data, time_t now, uint32 sender, uint8 messageType, uint32 stationery, uint32 checked, time_t deliverTime)
+{
+    // must be not checked yet
+    if (checked & MAIL_CHECK_MASK_READ)
+    {
+        return false;
+    }
+
+    // and already delivered
+    if (now < deliverTime)
+    {
+        return false;
+    }
+
+    data << ObjectGuid(HIGHGUID_PLAYER, sender);            // sender guid
+
+    switch (messageType)
+    {
+        case MAIL_AUCTION:
+            data << uint32(sender);                         // auction house id
+            data << uint32(MAIL_AUCTION);                   // message type
+            break;
+        default:
+            data << uint32(0);
+            data << uint32(0);
+            break;
+    }
+
+    data << uint32(stationery);
+    data << uint32(0xC6000000);                             // float unk, time or something
+    return true;
+}
+
 /**
  * No idea when this is called.
  */
@@ -878,42 +919,28 @@ void WorldSession::HandleQueryNextMailTime(WorldPacket & /**recv_data*/)
 
         uint32 count = 0;
         time_t now = time(NULL);
-        for (PlayerMails::iterator itr = _player->GetMailBegin(); itr != _player->GetMailEnd(); ++itr)
-        {
-            Mail* m = (*itr);
-            // must be not checked yet
-            if (m->checked & MAIL_CHECK_MASK_READ)
-            {
-                continue;
-            }
-
-            // and already delivered
-            if (now < m->deliver_time)
-            {
-                continue;
-            }
-
-            data << ObjectGuid(HIGHGUID_PLAYER, m->sender); // sender guid
 
-            switch (m->messageType)
+        // do not display more than 2 mails
+        if (_player->IsMailsLoaded())
+        {
+            for (PlayerMails::iterator itr = _player->GetMailBegin(); itr != _player->GetMailEnd() && count < 2; ++itr)
             {
-                case MAIL_AUCTION:
-                    data << uint32(m->sender);              // auction house id
-                    data << uint32(MAIL_AUCTION);           // message type
-                    break;
-                default:
-                    data << uint32(0);
-                    data << uint32(0);
-                    break;
+                Mail* m = (*itr);
+                if (AppendNextMailTimeEntry(data, now, m->sender, m->messageType, m->stationery, m->checked, m->deliver_time))
+                {
+                    ++count;
+                }
             }
-
-            data << uint32(m->stationery);
-            data << uint32(0xC6000000);                     // float unk, time or something
-
-            ++count;
-            if (count == 2)                                 // do not display more than 2 mails
+        }
+        else
+        {
+            PlayerMailIndex const& index = _player->GetMailIndex();
+            for (PlayerMailIndex::const_iterator itr = index.begin(); itr != index.end() && count < 2; ++itr)
             {
-                break;
+                if (AppendNextMailTimeEntry(data, now, itr->sender, itr->messageType, itr->stationery, itr->checked, itr->deliver_time))
+                {
+                    ++count;
+                }
             }
         }
         data.put<uint32>(4, count);
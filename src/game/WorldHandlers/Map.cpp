@@ -46,6 +46,9 @@
 #include "Calendar.h"
 #include "Chat.h"
 #include "Weather.h"
+#include "TickProfiler.h"
+#include "LineOfSightCache.h"
+#include "WhoListMgr.h"
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #include "ElunaConfig.h"
@@ -103,6 +106,9 @@ Map::~Map()
 
     delete m_weatherSystem;
     m_weatherSystem = NULL;
+
+    delete m_tickProfile;
+    delete m_losCache;
 }
 
 void Map::LoadMapAndVMap(int gx, int gy)
@@ -124,7 +130,7 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
       m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(NULL),
       m_activeNonPlayersIter(m_activeNonPlayers.end()),
       i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-      i_data(NULL)
+      i_data(NULL), m_tickProfile(NULL), m_losCache(NULL), m_losCacheVMapGeneration(m_TerrainData->GetVMapGeneration())
 {
 #ifdef ENABLE_ELUNA
     // lua state begins uninitialized
@@ -136,6 +142,11 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
     }
 #endif
 
+    if (uint32 losCacheSize = sWorld.getConfig(CONFIG_UINT32_LOS_CACHE_SIZE))
+    {
+        m_losCache = new LineOfSightCache(losCacheSize);
+    }
+
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
     m_GameObjectGuids.Set(sObjectMgr.GetFirstTemporaryGameObjectLowGuid());
 
@@ -263,6 +274,7 @@ void Map::RemoveFromGrid(Creature* obj, NGridType* grid, Cell const& cell)
 void Map::DeleteFromWorld(Player* pl)
 {
     sObjectAccessor.RemoveObject(pl);
+    sWhoListMgr.RemovePlayer(pl);
     delete pl;
 }
 
@@ -547,29 +559,53 @@ bool Map::loaded(const GridPair& p) const
 
 void Map::Update(const uint32& t_diff)
 {
-    m_dyn_tree.update(t_diff);
+    // the clock is only read while profiling, the phase timers do nothing without a profile
+    TickProfile* tickProfile = NULL;
+    std::chrono::steady_clock::time_point tickStart;
+    if (sWorld.getConfig(CONFIG_BOOL_TICK_PROFILER))
+    {
+        if (!m_tickProfile)
+        {
+            m_tickProfile = new TickProfile(MAX_MAP_TICK_PHASES);
+        }
+
+        tickProfile = m_tickProfile;
+        tickStart = std::chrono::steady_clock::now();
+    }
+
+    // models inserted since the last rebalance start to block sight now
+    if (m_dyn_tree.update(t_diff))
+    {
+        InvalidateLineOfSightCache();
+    }
 
     /// update worldsessions for existing players
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* plr = m_mapRefIter->getSource();
-        if (plr && plr->IsInWorld())
+        TickPhaseTimer phaseTimer(tickProfile, MAP_TICK_SESSIONS);
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            WorldSession* pSession = plr->GetSession();
-            MapSessionFilter updater(pSession);
+            Player* plr = m_mapRefIter->getSource();
+            if (plr && plr->IsInWorld())
+            {
+                WorldSession* pSession = plr->GetSession();
+                MapSessionFilter updater(pSession);
 
-            pSession->Update(updater);
+                pSession->Update(updater);
+            }
         }
     }
 
     /// update players at tick
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* plr = m_mapRefIter->getSource();
-        if (plr && plr->IsInWorld())
+        TickPhaseTimer phaseTimer(tickProfile, MAP_TICK_PLAYERS);
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            WorldObject::UpdateHelper helper(plr);
-            helper.Update(t_diff);
+            Player* plr = m_mapRefIter->getSource();
+            if (plr && plr->IsInWorld())
+            {
+                WorldObject::UpdateHelper helper(plr);
+                helper.Update(t_diff);
+            }
         }
     }
 
@@ -584,57 +620,19 @@ void Map::Update(const uint32& t_diff)
 
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
-    {
-        Player* plr = m_mapRefIter->getSource();
-
-        if (!plr->IsInWorld() || !plr->IsPositionValid())
-        {
-            continue;
-        }
-
-        // lets update mobs/objects in ALL visible cells around player!
-        CellArea area = Cell::CalculateCellArea(plr->GetPositionX(), plr->GetPositionY(), GetVisibilityDistance());
-
-        for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
-        {
-            for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
-            {
-                // marked cells are those that have been visited
-                // don't visit the same cell twice
-                uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                if (!isCellMarked(cell_id))
-                {
-                    markCell(cell_id);
-                    CellPair pair(x, y);
-                    Cell cell(pair);
-                    cell.SetNoCreate();
-                    Visit(cell, grid_object_update);
-                    Visit(cell, world_object_update);
-                }
-            }
-        }
-    }
-
-    // non-player active objects
-    if (!m_activeNonPlayers.empty())
     {
-        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        TickPhaseTimer phaseTimer(tickProfile, MAP_TICK_CELLS);
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            // skip not in world
-            WorldObject* obj = *m_activeNonPlayersIter;
+            Player* plr = m_mapRefIter->getSource();
 
-            // step before processing, in this case if Map::Remove remove next object we correctly
-            // step to next-next, and if we step to end() then newly added objects can wait next update.
-            ++m_activeNonPlayersIter;
-
-            if (!obj->IsInWorld() || !obj->IsPositionValid())
+            if (!plr->IsInWorld() || !plr->IsPositionValid())
             {
                 continue;
             }
 
             // lets update mobs/objects in ALL visible cells around player!
-            CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+            CellArea area = Cell::CalculateCellArea(plr->GetPositionX(), plr->GetPositionY(), GetVisibilityDistance());
 
             for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
             {
@@ -657,47 +655,108 @@ void Map::Update(const uint32& t_diff)
         }
     }
 
+    // non-player active objects
+    {
+        TickPhaseTimer phaseTimer(tickProfile, MAP_TICK_ACTIVE_OBJECTS);
+        if (!m_activeNonPlayers.empty())
+        {
+            for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+            {
+                // skip not in world
+                WorldObject* obj = *m_activeNonPlayersIter;
+
+                // step before processing, in this case if Map::Remove remove next object we correctly
+                // step to next-next, and if we step to end() then newly added objects can wait next update.
+                ++m_activeNonPlayersIter;
+
+                if (!obj->IsInWorld() || !obj->IsPositionValid())
+                {
+                    continue;
+                }
+
+                // lets update mobs/objects in ALL visible cells around player!
+                CellArea area = Cell::CalculateCellArea(obj->GetPositionX(), obj->GetPositionY(), GetVisibilityDistance());
+
+                for (uint32 x = area.low_bound.x_coord; x <= area.high_bound.x_coord; ++x)
+                {
+                    for (uint32 y = area.low_bound.y_coord; y <= area.high_bound.y_coord; ++y)
+                    {
+                        // marked cells are those that have been visited
+                        // don't visit the same cell twice
+                        uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
+                        if (!isCellMarked(cell_id))
+                        {
+                            markCell(cell_id);
+                            CellPair pair(x, y);
+                            Cell cell(pair);
+                            cell.SetNoCreate();
+                            Visit(cell, grid_object_update);
+                            Visit(cell, world_object_update);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     // Send world objects and item update field changes
-    SendObjectUpdates();
+    {
+        TickPhaseTimer phaseTimer(tickProfile, MAP_TICK_OBJECT_UPDATES);
+        SendObjectUpdates();
+    }
 
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
-    if (!IsBattleGroundOrArena())
     {
-        for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
+        TickPhaseTimer phaseTimer(tickProfile, MAP_TICK_GRIDS);
+        if (!IsBattleGroundOrArena())
         {
-            NGridType* grid = i->getSource();
-            GridInfo* info = i->getSource()->getGridInfoRef();
-            ++i;                                            // The update might delete the map and we need the next map before the iterator gets invalid
-            MANGOS_ASSERT(grid->GetGridState() >= 0 && grid->GetGridState() < MAX_GRID_STATE);
-            sMapMgr.UpdateGridState(grid->GetGridState(), *this, *grid, *info, grid->getX(), grid->getY(), t_diff);
+            for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end();)
+            {
+                NGridType* grid = i->getSource();
+                GridInfo* info = i->getSource()->getGridInfoRef();
+                ++i;                                            // The update might delete the map and we need the next map before the iterator gets invalid
+                MANGOS_ASSERT(grid->GetGridState() >= 0 && grid->GetGridState() < MAX_GRID_STATE);
+                sMapMgr.UpdateGridState(grid->GetGridState(), *this, *grid, *info, grid->getX(), grid->getY(), t_diff);
+            }
         }
     }
 
     ///- Process necessary scripts
-    if (!m_scriptSchedule.empty())
     {
-        ScriptsProcess();
-    }
+        TickPhaseTimer phaseTimer(tickProfile, MAP_TICK_SCRIPTS);
+        if (!m_scriptSchedule.empty())
+        {
+            ScriptsProcess();
+        }
 
 #ifdef ENABLE_ELUNA
-    if (Eluna* e = GetEluna())
-    {
-        if (!sElunaConfig->IsElunaCompatibilityMode())
+        if (Eluna* e = GetEluna())
         {
-            e->UpdateEluna(t_diff);
+            if (!sElunaConfig->IsElunaCompatibilityMode())
+            {
+                e->UpdateEluna(t_diff);
+            }
+
+            e->OnUpdate(this, t_diff);
         }
+#endif /* ENABLE_ELUNA */
 
-        e->OnUpdate(this, t_diff);
+        if (i_data)
+        {
+            i_data->Update(t_diff);
+        }
     }
-#endif /* ENABLE_ELUNA */
 
-    if (i_data)
     {
-        i_data->Update(t_diff);
+        TickPhaseTimer phaseTimer(tickProfile, MAP_TICK_WEATHERS);
+        m_weatherSystem->UpdateWeathers(t_diff);
     }
 
-    m_weatherSystem->UpdateWeathers(t_diff);
+    if (tickProfile)
+    {
+        tickProfile->AddSample(MAP_TICK_TOTAL, uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tickStart).count()));
+    }
 }
 
 void Map::Remove(Player* player, bool remove)
@@ -714,6 +773,8 @@ void Map::Remove(Player* player, bool remove)
         i_data->OnPlayerLeave(player);
     }
 
+    m_updatePlayers.erase(player->GetObjectGuid());
+
     if (remove)
     {
         player->CleanupsBeforeDelete();
@@ -2207,21 +2268,35 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
 
 void Map::SendObjectUpdates()
 {
-    UpdateDataMapType update_players;
-
-    while (!i_objectsToClientUpdate.empty())
+    // objects can be added or removed while building the updates, removed ones leave an empty slot
+    for (size_t i = 0; i < i_objectsToClientUpdate.size(); ++i)
     {
-        Object* obj = *i_objectsToClientUpdate.begin();
-        i_objectsToClientUpdate.erase(i_objectsToClientUpdate.begin());
-        obj->BuildUpdateData(update_players);
+        if (Object* obj = i_objectsToClientUpdate[i])
+        {
+            i_objectsToClientUpdate[i] = NULL;
+            obj->BuildUpdateData(m_updatePlayers);
+        }
     }
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    i_objectsToClientUpdate.clear();
+
+    WorldPacket packet;                                     // only borrows the buffers of the update data
+    for (UpdateDataMapType::iterator iter = m_updatePlayers.begin(); iter != m_updatePlayers.end();)
     {
-        iter->second.BuildPacket(&packet);
-        iter->first->GetSession()->SendPacket(&packet);
-        packet.clear();                                     // clean the string
+        Player* player = GetPlayer(iter->first);
+        if (!player)
+        {
+            m_updatePlayers.erase(iter++);
+            continue;
+        }
+
+        if (iter->second.HasData())
+        {
+            iter->second.SwapPacket(&packet);
+            player->GetSession()->SendPacket(&packet);
+            iter->second.RestoreBuffer(&packet);
+        }
+        ++iter;
     }
 }
 
@@ -2356,8 +2431,29 @@ void Map::PlayDirectSoundToMap(uint32 soundId, uint32 zoneId /*=0*/) const
  */
 bool Map::IsInLineOfSight(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, uint32 phasemask) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ)
-           && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask);
+    bool inLineOfSight;
+
+    // a vmap tile of the map was loaded or unloaded since, cached results may miss or contain its walls
+    if (m_losCache && m_losCacheVMapGeneration != m_TerrainData->GetVMapGeneration())
+    {
+        m_losCache->Invalidate();
+        m_losCacheVMapGeneration = m_TerrainData->GetVMapGeneration();
+    }
+
+    if (m_losCache && m_losCache->Find(srcX, srcY, srcZ, destX, destY, destZ, phasemask, inLineOfSight))
+    {
+        return inLineOfSight;
+    }
+
+    inLineOfSight = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), srcX, srcY, srcZ, destX, destY, destZ)
+                    && m_dyn_tree.isInLineOfSight(srcX, srcY, srcZ, destX, destY, destZ, phasemask);
+
+    if (m_losCache)
+    {
+        m_losCache->Insert(srcX, srcY, srcZ, destX, destY, destZ, phasemask, inLineOfSight);
+    }
+
+    return inLineOfSight;
 }
 
 /**
@@ -2465,11 +2561,13 @@ float Map::GetHeight(uint32 phasemask, float x, float y, float z) const
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.insert(mdl);
+    InvalidateLineOfSightCache();
 }
 
 void Map::RemoveGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.remove(mdl);
+    InvalidateLineOfSightCache();
 }
 
 bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
@@ -2477,6 +2575,14 @@ bool Map::ContainsGameObjectModel(const GameObjectModel& mdl) const
     return m_dyn_tree.contains(mdl);
 }
 
+void Map::InvalidateLineOfSightCache()
+{
+    if (m_losCache)
+    {
+        m_losCache->Invalidate();
+    }
+}
+
 // This will generate a random point to all directions in water for the provided point in radius range.
 bool Map::GetRandomPointUnderWater(uint32 phaseMask, float& x, float& y, float& z, float radius, GridMapLiquidData& liquid_status)
 {
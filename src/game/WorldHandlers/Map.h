@@ -48,6 +48,7 @@
 #include "LuaValue.h"
 #endif /* ENABLE_ELUNA */
 
+#include <algorithm>
 #include <bitset>
 #include <list>
 
@@ -69,6 +70,8 @@ class BattleGround;
 class GridMap;
 class GameObjectModel;
 class WeatherSystem;
+class TickProfile;
+class LineOfSightCache;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -269,14 +272,22 @@ class Map : public GridRefManager<NGridType>
         typedef TypeUnorderedMapContainer<AllMapStoredObjectTypes, ObjectGuid> MapStoredObjectTypesContainer;
         MapStoredObjectTypesContainer& GetObjectsStore() { return m_objectsStore; }
 
+        // objects guard against being added twice by their m_objectUpdated flag
         void AddUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.insert(obj);
+            obj->SetClientUpdateSlot(i_objectsToClientUpdate.size());
+            i_objectsToClientUpdate.push_back(obj);
         }
 
+        // only clear the slot, SendObjectUpdates may be iterating the list
+        // an item may be queued at the map its owner just left, so check the slot really holds the object
         void RemoveUpdateObject(Object* obj)
         {
-            i_objectsToClientUpdate.erase(obj);
+            uint32 slot = obj->GetClientUpdateSlot();
+            if (slot < i_objectsToClientUpdate.size() && i_objectsToClientUpdate[slot] == obj)
+            {
+                i_objectsToClientUpdate[slot] = NULL;
+            }
         }
 
         // DynObjects currently
@@ -287,6 +298,11 @@ class Map : public GridRefManager<NGridType>
 
         void CreateInstanceData(bool load);
         InstanceData* GetInstanceData() const { return i_data; }
+
+        // per phase update times, NULL until the tick profiler is enabled
+        TickProfile const* GetTickProfile() const { return m_tickProfile; }
+        // NULL if line of sight caching is disabled
+        LineOfSightCache const* GetLineOfSightCache() const { return m_losCache; }
         virtual uint32 GetScriptId() const { return sScriptMgr.GetBoundScriptId(SCRIPTED_MAP, GetId()); }
 
         void MonsterYellToMap(ObjectGuid guid, int32 textId, Language language, Unit const* target) const;
@@ -303,6 +319,8 @@ class Map : public GridRefManager<NGridType>
         void InsertGameObjectModel(const GameObjectModel& mdl);
         void RemoveGameObjectModel(const GameObjectModel& mdl);
         bool ContainsGameObjectModel(const GameObjectModel& mdl) const;
+        // must be called when a dynamic model changes its collision, cached line of sight results are dropped
+        void InvalidateLineOfSightCache();
 
         // Get Holder for Creature Linking
         CreatureLinkingHolder* GetCreatureLinkingHolder() { return &m_creatureLinkingHolder; }
@@ -368,7 +386,11 @@ class Map : public GridRefManager<NGridType>
         void ScriptsProcess();
 
         void SendObjectUpdates();
-        std::set<Object*> i_objectsToClientUpdate;
+        std::vector<Object*> i_objectsToClientUpdate;
+
+        // update data of every player of the map, kept between ticks to reuse their buffers
+        // keyed by guid, item updates can still add a player that already left, SendObjectUpdates drops those
+        UpdateDataMapType m_updatePlayers;
 
     protected:
         MapEntry const* i_mapEntry;
@@ -428,6 +450,10 @@ class Map : public GridRefManager<NGridType>
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
 
+        TickProfile* m_tickProfile;
+        LineOfSightCache* m_losCache;
+        mutable uint32 m_losCacheVMapGeneration;            // TerrainInfo vmap generation the cached results were computed with
+
 #ifdef ENABLE_ELUNA
         Eluna* eluna;
 #endif /* ENABLE_ELUNA */
@@ -89,21 +89,8 @@ void MapPersistentState::SaveCreatureRespawnTime(uint32 loguid, time_t t)
         return;
     }
 
-    CharacterDatabase.BeginTransaction();
-
-    static SqlStatementID delSpawnTime ;
-    static SqlStatementID insSpawnTime ;
-
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delSpawnTime, "DELETE FROM `creature_respawn` WHERE `guid` = ? AND `instance` = ?");
-    stmt.PExecute(loguid, m_instanceid);
-
-    if (t > sWorld.GetGameTime())
-    {
-        stmt = CharacterDatabase.CreateStatement(insSpawnTime, "INSERT INTO `creature_respawn` VALUES ( ?, ?, ? )");
-        stmt.PExecute(loguid, uint64(t), m_instanceid);
-    }
-
-    CharacterDatabase.CommitTransaction();
+    // written in batches by the manager, kills in farmed zones would be a transaction each otherwise
+    sMapPersistentStateMgr.ScheduleCreatureRespawnTimeSave(loguid, m_instanceid, t > sWorld.GetGameTime() ? t : 0);
 }
 
 void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
@@ -116,21 +103,8 @@ void MapPersistentState::SaveGORespawnTime(uint32 loguid, time_t t)
         return;
     }
 
-    CharacterDatabase.BeginTransaction();
-
-    static SqlStatementID delSpawnTime ;
-    static SqlStatementID insSpawnTime ;
-
-    SqlStatement stmt = CharacterDatabase.CreateStatement(delSpawnTime, "DELETE FROM `gameobject_respawn` WHERE `guid` = ? AND `instance` = ?");
-    stmt.PExecute(loguid, m_instanceid);
-
-    if (t > sWorld.GetGameTime())
-    {
-        stmt = CharacterDatabase.CreateStatement(insSpawnTime, "INSERT INTO `gameobject_respawn` VALUES ( ?, ?, ? )");
-        stmt.PExecute(loguid, uint64(t), m_instanceid);
-    }
-
-    CharacterDatabase.CommitTransaction();
+    // written in batches by the manager, kills in farmed zones would be a transaction each otherwise
+    sMapPersistentStateMgr.ScheduleGORespawnTimeSave(loguid, m_instanceid, t > sWorld.GetGameTime() ? t : 0);
 }
 
 void MapPersistentState::SetCreatureRespawnTime(uint32 loguid, time_t t)
@@ -279,6 +253,8 @@ void DungeonPersistentState::SaveToDB()
 
 void DungeonPersistentState::DeleteRespawnTimes()
 {
+    sMapPersistentStateMgr.DiscardPendingRespawnTimes(GetInstanceId());
+
     CharacterDatabase.BeginTransaction();
     CharacterDatabase.PExecute("DELETE FROM `creature_respawn` WHERE `instance` = '%u'", GetInstanceId());
     CharacterDatabase.PExecute("DELETE FROM `gameobject_respawn` WHERE `instance` = '%u'", GetInstanceId());
@@ -656,7 +632,7 @@ void DungeonResetScheduler::ResetAllRaid()
 
 //== MapPersistentStateManager functions =========================
 
-MapPersistentStateManager::MapPersistentStateManager() : lock_instLists(false), m_Scheduler(*this)
+MapPersistentStateManager::MapPersistentStateManager() : lock_instLists(false), m_Scheduler(*this), m_nextRespawnTimesFlush(0)
 {
 }
 
@@ -762,6 +738,8 @@ void MapPersistentStateManager::DeleteInstanceFromDB(uint32 instanceid)
 {
     if (instanceid)
     {
+        sMapPersistentStateMgr.DiscardPendingRespawnTimes(instanceid);
+
         CharacterDatabase.BeginTransaction();
         CharacterDatabase.PExecute("DELETE FROM `instance` WHERE `id` = '%u'", instanceid);
         CharacterDatabase.PExecute("DELETE FROM `character_instance` WHERE `instance` = '%u'", instanceid);
@@ -772,6 +750,119 @@ void MapPersistentStateManager::DeleteInstanceFromDB(uint32 instanceid)
     }
 }
 
+void MapPersistentStateManager::Update()
+{
+    m_Scheduler.Update();
+
+    if (sWorld.GetGameTime() >= m_nextRespawnTimesFlush)
+    {
+        FlushRespawnTimes();
+    }
+}
+
+void MapPersistentStateManager::DiscardPendingRespawnTimes(uint32 instanceId)
+{
+    PendingRespawnTimes::iterator begin = m_pendingCreatureRespawnTimes.lower_bound(std::make_pair(instanceId, uint32(0)));
+    PendingRespawnTimes::iterator end = m_pendingCreatureRespawnTimes.lower_bound(std::make_pair(instanceId + 1, uint32(0)));
+    m_pendingCreatureRespawnTimes.erase(begin, end);
+
+    begin = m_pendingGORespawnTimes.lower_bound(std::make_pair(instanceId, uint32(0)));
+    end = m_pendingGORespawnTimes.lower_bound(std::make_pair(instanceId + 1, uint32(0)));
+    m_pendingGORespawnTimes.erase(begin, end);
+}
+
+void MapPersistentStateManager::FlushRespawnTimes()
+{
+    m_nextRespawnTimesFlush = sWorld.GetGameTime() + sWorld.getConfig(CONFIG_UINT32_INTERVAL_SAVE_RESPAWN_TIME);
+
+    if (m_pendingCreatureRespawnTimes.empty() && m_pendingGORespawnTimes.empty())
+    {
+        return;
+    }
+
+    CharacterDatabase.BeginTransaction();
+    _FlushRespawnTimes(m_pendingCreatureRespawnTimes, "creature_respawn");
+    _FlushRespawnTimes(m_pendingGORespawnTimes, "gameobject_respawn");
+    CharacterDatabase.CommitTransaction();
+}
+
+void MapPersistentStateManager::_FlushRespawnTimes(PendingRespawnTimes& pending, char const* table)
+{
+    // keep single statements at a sane size
+    const uint32 maxRowsPerStatement = 500;
+
+    std::ostringstream replaceSql;
+    std::ostringstream deleteSql;
+    uint32 replaceRows = 0;
+    uint32 deleteRows = 0;
+    uint32 deleteInstance = 0;
+
+    for (PendingRespawnTimes::const_iterator itr = pending.begin(); itr != pending.end(); ++itr)
+    {
+        uint32 instanceId = itr->first.first;
+        uint32 loguid = itr->first.second;
+
+        if (itr->second)
+        {
+            if (replaceRows == maxRowsPerStatement)
+            {
+                CharacterDatabase.Execute(replaceSql.str().c_str());
+                replaceSql.str("");
+                replaceRows = 0;
+            }
+
+            if (!replaceRows)
+            {
+                replaceSql << "REPLACE INTO `" << table << "` (`guid`, `respawntime`, `instance`) VALUES ";
+            }
+            else
+            {
+                replaceSql << ",";
+            }
+
+            replaceSql << "(" << loguid << "," << uint64(itr->second) << "," << instanceId << ")";
+            ++replaceRows;
+        }
+        else
+        {
+            // deletes are grouped by instance, the map is sorted by it
+            if (deleteRows && (deleteRows == maxRowsPerStatement || deleteInstance != instanceId))
+            {
+                deleteSql << ")";
+                CharacterDatabase.Execute(deleteSql.str().c_str());
+                deleteSql.str("");
+                deleteRows = 0;
+            }
+
+            if (!deleteRows)
+            {
+                deleteSql << "DELETE FROM `" << table << "` WHERE `instance` = " << instanceId << " AND `guid` IN (";
+                deleteInstance = instanceId;
+            }
+            else
+            {
+                deleteSql << ",";
+            }
+
+            deleteSql << loguid;
+            ++deleteRows;
+        }
+    }
+
+    if (replaceRows)
+    {
+        CharacterDatabase.Execute(replaceSql.str().c_str());
+    }
+
+    if (deleteRows)
+    {
+        deleteSql << ")";
+        CharacterDatabase.Execute(deleteSql.str().c_str());
+    }
+
+    pending.clear();
+}
+
 void MapPersistentStateManager::RemovePersistentState(uint32 mapId, uint32 instanceId)
 {
     if (lock_instLists)
@@ -380,9 +380,21 @@ class MapPersistentStateManager : public MaNGOS::Singleton<MapPersistentStateMan
 
         void GetStatistics(uint32& numStates, uint32& numBoundPlayers, uint32& numBoundGroups);
 
-        void Update() { m_Scheduler.Update(); }
+        void Update();
+
+    public:                                                 // respawn times write-behind
+        // t == 0 deletes the stored respawn time, written at next FlushRespawnTimes
+        void ScheduleCreatureRespawnTimeSave(uint32 loguid, uint32 instanceId, time_t t) { m_pendingCreatureRespawnTimes[std::make_pair(instanceId, loguid)] = t; }
+        void ScheduleGORespawnTimeSave(uint32 loguid, uint32 instanceId, time_t t) { m_pendingGORespawnTimes[std::make_pair(instanceId, loguid)] = t; }
+        // called when the DB rows of the instance are deleted, pending writes would bring them back
+        void DiscardPendingRespawnTimes(uint32 instanceId);
+        void FlushRespawnTimes();
+
     private:
         typedef std::unordered_map < uint32 /*InstanceId or MapId*/, MapPersistentState* > PersistentStateMap;
+        typedef std::map < std::pair<uint32 /*InstanceId*/, uint32 /*guid*/>, time_t /*respawn time, 0 to delete*/ > PendingRespawnTimes;
+
+        static void _FlushRespawnTimes(PendingRespawnTimes& pending, char const* table);
 
         //  called by scheduler for DungeonPersistentStates
         void _ResetOrWarnAll(uint32 mapid, Difficulty difficulty, bool warn, uint32 timeleft);
@@ -400,6 +412,11 @@ class MapPersistentStateManager : public MaNGOS::Singleton<MapPersistentStateMan
         PersistentStateMap m_instanceSaveByMapId;
 
         DungeonResetScheduler m_Scheduler;
+
+        // sorted by instance, so deletes can be grouped by it
+        PendingRespawnTimes m_pendingCreatureRespawnTimes;
+        PendingRespawnTimes m_pendingGORespawnTimes;
+        time_t m_nextRespawnTimesFlush;
 };
 
 template<typename Do>
@@ -290,6 +290,7 @@ namespace MMAP
         }
 
         mmap->mmapLoadedTiles.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+        ++mmap->tileGeneration;
         ++loadedTiles;
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:loadMap: Loaded mmtile %03i[%02i,%02i] into %03i[%02i,%02i]", mapId, x, y, mapId, header->x, header->y);
         return true;
@@ -330,6 +331,7 @@ namespace MMAP
         else
         {
             mmap->mmapLoadedTiles.erase(packedGridPos);
+            ++mmap->tileGeneration;
             --loadedTiles;
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded mmtile %03i[%02i,%02i] from %03i", mapId, x, y, mapId);
             return true;
@@ -392,6 +394,13 @@ namespace MMAP
 
         dtFreeNavMeshQuery(query);
         mmap->navMeshQueries.erase(instanceId);
+
+        PathCorridorCacheSet::iterator cacheItr = mmap->corridorCaches.find(instanceId);
+        if (cacheItr != mmap->corridorCaches.end())
+        {
+            delete cacheItr->second;
+            mmap->corridorCaches.erase(cacheItr);
+        }
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
 
         return true;
@@ -433,4 +442,102 @@ namespace MMAP
 
         return mmap->navMeshQueries[instanceId];
     }
+
+    PathCorridorCache* MMapManager::GetPathCorridorCache(uint32 mapId, uint32 instanceId)
+    {
+        uint32 maxSize = sWorld.getConfig(CONFIG_UINT32_MMAP_PATH_CACHE_SIZE);
+        if (!maxSize)
+        {
+            return NULL;
+        }
+
+        MMapDataSet::iterator itr = loadedMMaps.find(mapId);
+        if (itr == loadedMMaps.end())
+        {
+            return NULL;
+        }
+
+        MMapData* mmap = itr->second;
+        PathCorridorCacheSet::iterator cacheItr = mmap->corridorCaches.find(instanceId);
+        if (cacheItr != mmap->corridorCaches.end())
+        {
+            return cacheItr->second;
+        }
+
+        PathCorridorCache* cache = new PathCorridorCache(maxSize, &mmap->tileGeneration);
+        mmap->corridorCaches.insert(std::pair<uint32, PathCorridorCache*>(instanceId, cache));
+        return cache;
+    }
+
+    // ######################## PathCorridorCache ########################
+    bool PathCorridorCache::Find(dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags,
+                                 dtPolyRef* path, uint32& pathSize, uint32 maxPathSize)
+    {
+        CheckTileGeneration();
+
+        CorridorKey key = { startPoly, endPoly, uint32(includeFlags) << 16 | excludeFlags };
+        CorridorIndex::iterator itr = m_index.find(key);
+        if (itr == m_index.end() || itr->second->path.size() > maxPathSize)
+        {
+            ++m_misses;
+            return false;
+        }
+
+        // move to front, it is the most recently used one now
+        m_corridors.splice(m_corridors.begin(), m_corridors, itr->second);
+
+        std::vector<dtPolyRef> const& corridor = itr->second->path;
+        std::copy(corridor.begin(), corridor.end(), path);
+        pathSize = corridor.size();
+
+        ++m_hits;
+        return true;
+    }
+
+    void PathCorridorCache::Insert(dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags,
+                                   dtPolyRef const* path, uint32 pathSize)
+    {
+        CheckTileGeneration();
+
+        CorridorKey key = { startPoly, endPoly, uint32(includeFlags) << 16 | excludeFlags };
+        CorridorIndex::iterator itr = m_index.find(key);
+        if (itr != m_index.end())
+        {
+            itr->second->path.assign(path, path + pathSize);
+            m_corridors.splice(m_corridors.begin(), m_corridors, itr->second);
+            return;
+        }
+
+        if (m_index.size() >= m_maxSize)
+        {
+            // evict least recently used corridor, reuse its storage
+            m_index.erase(m_corridors.back().key);
+            m_corridors.splice(m_corridors.begin(), m_corridors, --m_corridors.end());
+        }
+        else
+        {
+            m_corridors.push_front(CorridorEntry());
+        }
+
+        CorridorEntry& entry = m_corridors.front();
+        entry.key = key;
+        entry.path.assign(path, path + pathSize);
+        m_index[key] = m_corridors.begin();
+    }
+
+    void PathCorridorCache::Clear()
+    {
+        m_index.clear();
+        m_corridors.clear();
+    }
+
+    void PathCorridorCache::CheckTileGeneration()
+    {
+        uint32 generation = *m_tileGeneration;
+        if (generation != m_generation)
+        {
+            Clear();
+            m_generation = generation;
+        }
+    }
 }
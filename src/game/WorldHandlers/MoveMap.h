@@ -27,6 +27,11 @@
 
 #include "Define.h"
 
+#include <atomic>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
 #include "../../dep/recastnavigation/Detour/Include/DetourAlloc.h"
 #include "../../dep/recastnavigation/Detour/Include/DetourNavMesh.h"
 #include "../../dep/recastnavigation/Detour/Include/DetourNavMeshQuery.h"
@@ -47,13 +52,77 @@ inline void dtCustomFree(void* ptr)
 //  move map related classes
 namespace MMAP
 {
+    // LRU cache of recently built poly corridors (start poly -> end poly)
+    // units of a pack chasing the same target reuse the corridor instead of running findPath again
+    // same as dtNavMeshQuery it is NOT threadsafe, every map instance uses its own cache
+    class PathCorridorCache
+    {
+        public:
+            PathCorridorCache(uint32 maxSize, std::atomic<uint32> const* tileGeneration) :
+                m_maxSize(maxSize), m_tileGeneration(tileGeneration), m_generation(*tileGeneration), m_hits(0), m_misses(0) {}
+
+            // copies the cached corridor into path, return false if there is none
+            bool Find(dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags,
+                      dtPolyRef* path, uint32& pathSize, uint32 maxPathSize);
+            void Insert(dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags,
+                        dtPolyRef const* path, uint32 pathSize);
+            void Clear();
+
+            uint32 GetSize() const { return m_index.size(); }
+            uint32 GetMaxSize() const { return m_maxSize; }
+            uint32 GetHits() const { return m_hits; }
+            uint32 GetMisses() const { return m_misses; }
+
+        private:
+            struct CorridorKey
+            {
+                dtPolyRef startPoly;
+                dtPolyRef endPoly;
+                uint32 filterFlags;                 // include flags << 16 | exclude flags
+
+                bool operator==(CorridorKey const& other) const
+                {
+                    return startPoly == other.startPoly && endPoly == other.endPoly && filterFlags == other.filterFlags;
+                }
+            };
+
+            struct CorridorKeyHash
+            {
+                size_t operator()(CorridorKey const& key) const
+                {
+                    return std::hash<uint64>()(uint64(key.startPoly) * 31 + uint64(key.endPoly)) ^ key.filterFlags;
+                }
+            };
+
+            struct CorridorEntry
+            {
+                CorridorKey key;
+                std::vector<dtPolyRef> path;
+            };
+
+            typedef std::list<CorridorEntry> CorridorList;
+            typedef std::unordered_map<CorridorKey, CorridorList::iterator, CorridorKeyHash> CorridorIndex;
+
+            // drop everything built against tiles which are not loaded anymore
+            void CheckTileGeneration();
+
+            CorridorList m_corridors;               // most recently used first
+            CorridorIndex m_index;
+            uint32 m_maxSize;
+            std::atomic<uint32> const* m_tileGeneration;
+            uint32 m_generation;
+            uint32 m_hits;
+            uint32 m_misses;
+    };
+
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<uint32, PathCorridorCache*> PathCorridorCacheSet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) {}
+        MMapData(dtNavMesh* mesh) : navMesh(mesh), tileGeneration(0) {}
         ~MMapData()
         {
             for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
@@ -61,6 +130,11 @@ namespace MMAP
                 dtFreeNavMeshQuery(i->second);
             }
 
+            for (PathCorridorCacheSet::iterator i = corridorCaches.begin(); i != corridorCaches.end(); ++i)
+            {
+                delete i->second;
+            }
+
             if (navMesh)
             {
                 dtFreeNavMesh(navMesh);
@@ -71,7 +145,9 @@ namespace MMAP
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries;     // instanceId to query
+        PathCorridorCacheSet corridorCaches;// instanceId to corridor cache, used together with the query
         MMapTileSet mmapLoadedTiles;        // maps [map grid coords] to [dtTile]
+        std::atomic<uint32> tileGeneration; // changed on every tile load/unload, invalidates cached corridors
     };
 
 
@@ -92,6 +168,8 @@ namespace MMAP
 
             // the returned [dtNavMeshQuery const*] is NOT threadsafe
             dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            // NULL if corridor caching is disabled, NOT threadsafe either
+            PathCorridorCache* GetPathCorridorCache(uint32 mapId, uint32 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
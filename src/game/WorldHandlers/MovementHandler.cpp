@@ -384,9 +384,22 @@ void WorldSession::HandleMovementOpcodes(WorldPacket& recv_data)
         mover->SetUInt32Value(UNIT_NPC_EMOTESTATE, EMOTE_ONESHOT_NONE);
     }
 
+    // start/stop/jump and any other change of movement flags must reach every observer,
+    // only plain heartbeats may be skipped for distant ones
+    uint32 heartbeat = 0;
+    if (opcode == MSG_MOVE_HEARTBEAT && movementInfo.GetMovementFlags() == m_lastBroadcastMoveFlags)
+    {
+        heartbeat = ++m_moveHeartbeatCount;
+    }
+    else
+    {
+        m_moveHeartbeatCount = 0;
+    }
+    m_lastBroadcastMoveFlags = movementInfo.GetMovementFlags();
+
     WorldPacket data(SMSG_PLAYER_MOVE, recv_data.size());
     data << movementInfo;
-    mover->SendMessageToSetExcept(&data, _player);
+    mover->SendMovementMessageToSetExcept(&data, _player, heartbeat);
 }
 
 void WorldSession::HandleForceSpeedChangeAckOpcodes(WorldPacket& recv_data)
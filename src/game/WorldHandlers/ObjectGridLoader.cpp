@@ -112,9 +112,36 @@ template<> void addUnitState(Creature* obj, CellPair const& cell_pair)
     obj->SetCurrentCell(cell);
 }
 
+template <class T>
+void AddLoadedObjectToGrid(T* obj, CellPair& cell, Map* map, GridType& grid, BattleGround* bg)
+{
+    grid.AddGridObject(obj);
+
+    addUnitState(obj, cell);
+    obj->SetMap(map);
+    obj->AddToWorld();
+    if (obj->IsActiveObject())
+    {
+        map->AddToActive(obj);
+    }
+
+    obj->GetViewPoint().Event_AddedToWorld(&grid);
+
+    if (bg)
+    {
+        bg->OnObjectDBLoad(obj);
+    }
+}
+
+// map instance specific spawns (pools), spawn data still has to be looked up
 template <class T>
 void LoadHelper(CellGuidSet const& guid_set, CellPair& cell, GridRefManager<T>& /*m*/, uint32& count, Map* map, GridType& grid)
 {
+    if (guid_set.empty())
+    {
+        return;
+    }
+
     BattleGround* bg = map->IsBattleGroundOrArena() ? ((BattleGroundMap*)map)->GetBG() : NULL;
 
     for (CellGuidSet::const_iterator i_guid = guid_set.begin(); i_guid != guid_set.end(); ++i_guid)
@@ -129,23 +156,32 @@ void LoadHelper(CellGuidSet const& guid_set, CellPair& cell, GridRefManager<T>&
             continue;
         }
 
-        grid.AddGridObject(obj);
+        AddLoadedObjectToGrid(obj, cell, map, grid, bg);
+        ++count;
+    }
+}
 
-        addUnitState(obj, cell);
-        obj->SetMap(map);
-        obj->AddToWorld();
-        if (obj->IsActiveObject())
-        {
-            map->AddToActive(obj);
-        }
+// static spawns, the cell spawn list already holds the spawn data
+template <class T, class D>
+void LoadHelper(std::vector<CellSpawnEntry<D> > const& spawns, CellPair& cell, GridRefManager<T>& /*m*/, uint32& count, Map* map, GridType& grid)
+{
+    if (spawns.empty())
+    {
+        return;
+    }
 
-        obj->GetViewPoint().Event_AddedToWorld(&grid);
+    BattleGround* bg = map->IsBattleGroundOrArena() ? ((BattleGroundMap*)map)->GetBG() : NULL;
 
-        if (bg)
+    for (typename std::vector<CellSpawnEntry<D> >::const_iterator itr = spawns.begin(); itr != spawns.end(); ++itr)
+    {
+        T* obj = new T;
+        if (!obj->LoadFromDB(itr->guid, itr->data, map))
         {
-            bg->OnObjectDBLoad(obj);
+            delete obj;
+            continue;
         }
 
+        AddLoadedObjectToGrid(obj, cell, map, grid, bg);
         ++count;
     }
 }
@@ -857,6 +857,7 @@ void Spell::FillTargetMap()
             }
         }
 
+        // filter and add in one pass, dropped targets stay dropped for effects sharing this list
         for (UnitList::iterator itr = tmpUnitLists[effToIndex[i]].begin(); itr != tmpUnitLists[effToIndex[i]].end();)
         {
             if (!CheckTarget(*itr, SpellEffectIndex(i)))
@@ -864,15 +865,9 @@ void Spell::FillTargetMap()
                 itr = tmpUnitLists[effToIndex[i]].erase(itr);
                 continue;
             }
-            else
-            {
-                ++itr;
-            }
-        }
 
-        for (UnitList::const_iterator iunit = tmpUnitLists[effToIndex[i]].begin(); iunit != tmpUnitLists[effToIndex[i]].end(); ++iunit)
-        {
-            AddUnitTarget((*iunit), SpellEffectIndex(i));
+            AddUnitTarget((*itr), SpellEffectIndex(i));
+            ++itr;
         }
     }
 }
@@ -1025,6 +1020,7 @@ void Spell::prepareDataForTriggerSystem()
 void Spell::CleanupTargetList()
 {
     m_UniqueTargetInfo.clear();
+    m_UniqueTargetIndex.clear();
     m_UniqueGOTargetInfo.clear();
     m_UniqueItemInfo.clear();
     m_delayMoment = 0;
@@ -1049,16 +1045,14 @@ void Spell::AddUnitTarget(Unit* pVictim, SpellEffectIndex effIndex)
     ObjectGuid targetGUID = pVictim->GetObjectGuid();
 
     // Lookup target in already in list
-    for (TargetList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    TargetIndex::iterator indexItr = std::lower_bound(m_UniqueTargetIndex.begin(), m_UniqueTargetIndex.end(), targetGUID, TargetIndexGuidLess());
+    if (indexItr != m_UniqueTargetIndex.end() && indexItr->first == targetGUID)
     {
-        if (targetGUID == ihit->targetGUID)                 // Found in list
+        if (!immuned)
         {
-            if (!immuned)
-            {
-                ihit->effectMask |= 1 << effIndex;          // Add only effect mask if not immuned
-            }
-            return;
+            indexItr->second->effectMask |= 1 << effIndex;  // Add only effect mask if not immuned
         }
+        return;
     }
 
     // This is new target calculate data for him
@@ -1148,6 +1142,7 @@ void Spell::AddUnitTarget(Unit* pVictim, SpellEffectIndex effIndex)
 
     // Add target to list
     m_UniqueTargetInfo.push_back(target);
+    m_UniqueTargetIndex.insert(indexItr, TargetIndex::value_type(targetGUID, &m_UniqueTargetInfo.back()));
 }
 
 void Spell::AddUnitTarget(ObjectGuid unitGuid, SpellEffectIndex effIndex)
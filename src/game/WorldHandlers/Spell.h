@@ -663,7 +663,16 @@ class Spell
         typedef std::list<GOTargetInfo>   GOTargetList;
         typedef std::list<ItemTargetInfo> ItemTargetList;
 
+        // m_UniqueTargetInfo entries sorted by target guid, AoE target filling looks up duplicates here
+        typedef std::vector<std::pair<ObjectGuid, TargetInfo*> > TargetIndex;
+
+        struct TargetIndexGuidLess
+        {
+            bool operator()(TargetIndex::value_type const& entry, ObjectGuid guid) const { return entry.first < guid; }
+        };
+
         TargetList     m_UniqueTargetInfo;
+        TargetIndex    m_UniqueTargetIndex;
         GOTargetList   m_UniqueGOTargetInfo;
         ItemTargetList m_UniqueItemInfo;
 
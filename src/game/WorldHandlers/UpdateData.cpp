@@ -33,8 +33,19 @@
 #include "zlib.h"
 
 
-UpdateData::UpdateData(uint16 map) : m_blockCount(0), m_map(map)
+UpdateData::UpdateData(uint16 map) : m_blockCount(0)
 {
+    ResetBuffer();
+    m_map = map;
+}
+
+void UpdateData::ResetBuffer()
+{
+    // keep space for the packet header, so the buffer can be sent without moving the blocks
+    m_data.clear();
+    m_data.resize(UPDATE_DATA_HEADER_SIZE);
+    // a reused update data gets the map id of its next packet from BuildUpdateDataForPlayer
+    m_map = 0;
 }
 
 void UpdateData::AddOutOfRangeGUID(GuidSet& guids)
@@ -107,52 +118,64 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
 {
     MANGOS_ASSERT(packet->empty());                         // shouldn't happen
 
-    ByteBuffer buf(4 + (m_outOfRangeGUIDs.empty() ? 0 : 1 + 4 + 9 * m_outOfRangeGUIDs.size()) + m_data.wpos());
+    if (m_outOfRangeGUIDs.empty())
+    {
+        m_data.put<uint16>(0, m_map);
+        m_data.put<uint32>(2, m_blockCount);
+        packet->append(m_data);
+    }
+    else
+    {
+        packet->reserve(UPDATE_DATA_HEADER_SIZE + 1 + 4 + 9 * m_outOfRangeGUIDs.size() + m_data.wpos());
 
-    buf << uint16(m_map);
-    buf << uint32(!m_outOfRangeGUIDs.empty() ? m_blockCount + 1 : m_blockCount);
+        *packet << uint16(m_map);
+        *packet << uint32(m_blockCount + 1);
 
-    if (!m_outOfRangeGUIDs.empty())
-    {
-        buf << uint8(UPDATETYPE_OUT_OF_RANGE_OBJECTS);
-        buf << uint32(m_outOfRangeGUIDs.size());
+        *packet << uint8(UPDATETYPE_OUT_OF_RANGE_OBJECTS);
+        *packet << uint32(m_outOfRangeGUIDs.size());
 
         for (GuidSet::const_iterator i = m_outOfRangeGUIDs.begin(); i != m_outOfRangeGUIDs.end(); ++i)
         {
-            buf << i->WriteAsPacked();
+            *packet << i->WriteAsPacked();
         }
-    }
 
-    buf.append(m_data);
-
-    size_t pSize = buf.wpos();                              // use real used data size
-
-    //if (pSize > 100)                                        // compress large packets
-    //{
-    //    uint32 destsize = compressBound(pSize);
-    //    packet->resize(destsize + sizeof(uint32));
+        packet->append(m_data.contents() + UPDATE_DATA_HEADER_SIZE, m_data.wpos() - UPDATE_DATA_HEADER_SIZE);
+    }
 
-    //    packet->put<uint32>(0, pSize);
-    //    Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
-    //    if (destsize == 0)
-    //        return false;
+    packet->SetOpcode(SMSG_UPDATE_OBJECT);
+    return true;
+}
 
-    //    packet->resize(destsize + sizeof(uint32));
-    //    packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
-    //}
-    //else                                                    // send small packets without compression
+bool UpdateData::SwapPacket(WorldPacket* packet)
+{
+    // out of range guids have to be placed in front of the blocks
+    if (!m_outOfRangeGUIDs.empty())
     {
-        packet->append(buf);
-        packet->SetOpcode(SMSG_UPDATE_OBJECT);
+        return BuildPacket(packet);
     }
 
+    MANGOS_ASSERT(packet->empty());                         // shouldn't happen
+
+    m_data.put<uint16>(0, m_map);
+    m_data.put<uint32>(2, m_blockCount);
+    packet->swap(m_data);
+    packet->SetOpcode(SMSG_UPDATE_OBJECT);
     return true;
 }
 
+void UpdateData::RestoreBuffer(WorldPacket* packet)
+{
+    m_data.swap(*packet);
+    packet->clear();
+
+    ResetBuffer();
+    m_outOfRangeGUIDs.clear();
+    m_blockCount = 0;
+}
+
 void UpdateData::Clear()
 {
-    m_data.clear();
+    ResetBuffer();
     m_outOfRangeGUIDs.clear();
     m_blockCount = 0;
-    m_map = 0;
 }
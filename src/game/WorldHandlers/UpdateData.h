@@ -30,6 +30,8 @@
 
 class WorldPacket;
 
+#define UPDATE_DATA_HEADER_SIZE (2 + 4)                     // map id and block count, written in front of the update blocks
+
 enum ObjectUpdateType
 {
     UPDATETYPE_VALUES               = 0,
@@ -68,6 +70,10 @@ class UpdateData
         void AddUpdateBlock() { ++m_blockCount; }
         ByteBuffer& GetBuffer() { return m_data; }
         bool BuildPacket(WorldPacket* packet);
+        // same as BuildPacket but hands the buffer over to the packet instead of copying it
+        bool SwapPacket(WorldPacket* packet);
+        // take the buffer back from the sent packet, the update data is empty afterwards
+        void RestoreBuffer(WorldPacket* packet);
         bool HasData() { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
         void Clear();
 
@@ -82,5 +88,6 @@ class UpdateData
         ByteBuffer m_data;
 
         void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+        void ResetBuffer();
 };
 #endif
@@ -0,0 +1,323 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "WhoListMgr.h"
+#include "DBCStores.h"
+#include "GuildMgr.h"
+#include "Player.h"
+#include "Policies/Singleton.h"
+#include "Timer.h"
+#include "Util.h"
+#include "World.h"
+#include "WorldSession.h"
+
+#include <tuple>
+
+INSTANTIATE_SINGLETON_1(WhoListMgr);
+
+#define MAX_WHO_LIST_RESULTS 50                             // client limit
+#define MAX_WHO_LIST_CACHE_SIZE 256
+
+bool WhoListQuery::operator<(WhoListQuery const& other) const
+{
+    return std::tie(team, locale, levelMin, levelMax, raceMask, classMask, zoneIds, playerName, guildName, strings) <
+           std::tie(other.team, other.locale, other.levelMin, other.levelMax, other.raceMask, other.classMask, other.zoneIds, other.playerName, other.guildName, other.strings);
+}
+
+void WhoListMgr::AddPlayer(Player* player)
+{
+    RemovePlayer(player);
+
+    WhoListEntry& entry = m_entries[player->GetGUIDLow()];
+    entry.player = player;
+    entry.name = player->GetName();
+    Utf8toWStr(entry.name, entry.wname);
+    wstrToLower(entry.wname);
+    entry.guildName = sGuildMgr.GetGuildNameById(player->GetGuildId());
+    Utf8toWStr(entry.guildName, entry.wguildName);
+    wstrToLower(entry.wguildName);
+    entry.level = player->getLevel();
+    entry.zoneId = player->GetZoneId();
+    entry.race = player->getRace();
+    entry.class_ = player->getClass();
+    entry.gender = player->getGender();
+    entry.team = player->GetTeam();
+
+    AddToBucket(m_levelBuckets, entry.level, &entry);
+    AddToBucket(m_zoneBuckets, entry.zoneId, &entry);
+}
+
+void WhoListMgr::RemovePlayer(Player* player)
+{
+    WhoListEntryMap::iterator itr = m_entries.find(player->GetGUIDLow());
+    if (itr == m_entries.end())
+    {
+        return;
+    }
+
+    RemoveFromBucket(m_levelBuckets, itr->second.level, &itr->second);
+    RemoveFromBucket(m_zoneBuckets, itr->second.zoneId, &itr->second);
+    m_entries.erase(itr);
+}
+
+void WhoListMgr::UpdateLevel(Player* player)
+{
+    WhoListEntryMap::iterator itr = m_entries.find(player->GetGUIDLow());
+    if (itr == m_entries.end() || itr->second.level == player->getLevel())
+    {
+        return;
+    }
+
+    RemoveFromBucket(m_levelBuckets, itr->second.level, &itr->second);
+    itr->second.level = player->getLevel();
+    AddToBucket(m_levelBuckets, itr->second.level, &itr->second);
+}
+
+void WhoListMgr::UpdateZone(Player* player, uint32 zoneId)
+{
+    WhoListEntryMap::iterator itr = m_entries.find(player->GetGUIDLow());
+    if (itr == m_entries.end() || itr->second.zoneId == zoneId)
+    {
+        return;
+    }
+
+    RemoveFromBucket(m_zoneBuckets, itr->second.zoneId, &itr->second);
+    itr->second.zoneId = zoneId;
+    AddToBucket(m_zoneBuckets, zoneId, &itr->second);
+}
+
+void WhoListMgr::UpdateGuild(Player* player)
+{
+    WhoListEntryMap::iterator itr = m_entries.find(player->GetGUIDLow());
+    if (itr == m_entries.end())
+    {
+        return;
+    }
+
+    itr->second.guildName = sGuildMgr.GetGuildNameById(player->GetGuildId());
+    itr->second.wguildName.clear();
+    Utf8toWStr(itr->second.guildName, itr->second.wguildName);
+    wstrToLower(itr->second.wguildName);
+}
+
+void WhoListMgr::AddToBucket(WhoListBucketMap& buckets, uint32 key, WhoListEntry* entry)
+{
+    buckets[key][entry->player->GetGUIDLow()] = entry;
+}
+
+void WhoListMgr::RemoveFromBucket(WhoListBucketMap& buckets, uint32 key, WhoListEntry* entry)
+{
+    WhoListBucketMap::iterator itr = buckets.find(key);
+    if (itr == buckets.end())
+    {
+        return;
+    }
+
+    itr->second.erase(entry->player->GetGUIDLow());
+    if (itr->second.empty())
+    {
+        buckets.erase(itr);
+    }
+}
+
+bool WhoListMgr::IsMatching(WhoListEntry const& entry, WhoListQuery const& query, WorldSession* session)
+{
+    Player* pl = entry.player;
+
+    // player can see member of other team only if CONFIG_BOOL_ALLOW_TWO_SIDE_WHO_LIST
+    if (query.team && entry.team != Team(query.team))
+    {
+        return false;
+    }
+
+    // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
+    if (session->GetSecurity() == SEC_PLAYER && pl->GetSession()->GetSecurity() > AccountTypes(sWorld.getConfig(CONFIG_UINT32_GM_LEVEL_IN_WHO_LIST)))
+    {
+        return false;
+    }
+
+    // do not process players which are not in world
+    if (!pl->IsInWorld())
+    {
+        return false;
+    }
+
+    // check if target is globally visible for player
+    if (!pl->IsVisibleGloballyFor(session->GetPlayer()))
+    {
+        return false;
+    }
+
+    if (entry.level < query.levelMin || entry.level > query.levelMax)
+    {
+        return false;
+    }
+
+    if (!(query.classMask & (1 << entry.class_)) || !(query.raceMask & (1 << entry.race)))
+    {
+        return false;
+    }
+
+    if (!query.zoneIds.empty() && std::find(query.zoneIds.begin(), query.zoneIds.end(), entry.zoneId) == query.zoneIds.end())
+    {
+        return false;
+    }
+
+    if (!query.playerName.empty() && entry.wname.find(query.playerName) == std::wstring::npos)
+    {
+        return false;
+    }
+
+    if (!query.guildName.empty() && entry.wguildName.find(query.guildName) == std::wstring::npos)
+    {
+        return false;
+    }
+
+    if (query.strings.empty())
+    {
+        return true;
+    }
+
+    std::string aname;
+    if (AreaTableEntry const* areaEntry = GetAreaEntryByAreaID(entry.zoneId))
+    {
+        aname = areaEntry->area_name[query.locale];
+    }
+
+    for (std::vector<std::wstring>::const_iterator itr = query.strings.begin(); itr != query.strings.end(); ++itr)
+    {
+        if (entry.wguildName.find(*itr) != std::wstring::npos ||
+            entry.wname.find(*itr) != std::wstring::npos ||
+            Utf8FitTo(aname, *itr))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WhoListMgr::BuildWhoList(WhoListQuery const& query, WorldSession* session, WorldPacket& data)
+{
+    // results depend on the visibility rules of the viewer, only share them between players
+    uint32 cacheTime = sWorld.getConfig(CONFIG_UINT32_WHO_LIST_CACHE_TIME);
+    bool useCache = cacheTime && session->GetSecurity() == SEC_PLAYER;
+
+    if (useCache)
+    {
+        RemoveExpiredResults(cacheTime);
+
+        WhoListCache::const_iterator itr = m_cache.find(query);
+        if (itr != m_cache.end())
+        {
+            data.Initialize(SMSG_WHO, itr->second.packet.size());
+            data.append(itr->second.packet);
+            return;
+        }
+    }
+
+    uint32 clientcount = 0;
+
+    data.Initialize(SMSG_WHO, 50);                          // guess size
+    data << uint32(clientcount);                            // clientcount place holder, listed count
+    data << uint32(clientcount);                            // clientcount place holder, online count
+
+    // look only at the players in the requested zones, or else in the requested level range
+    std::vector<WhoListBucket const*> candidates;
+    if (!query.zoneIds.empty())
+    {
+        for (uint32 i = 0; i < query.zoneIds.size(); ++i)
+        {
+            // client may send a zone twice
+            if (std::find(query.zoneIds.begin(), query.zoneIds.begin() + i, query.zoneIds[i]) != query.zoneIds.begin() + i)
+            {
+                continue;
+            }
+
+            WhoListBucketMap::const_iterator itr = m_zoneBuckets.find(query.zoneIds[i]);
+            if (itr != m_zoneBuckets.end())
+            {
+                candidates.push_back(&itr->second);
+            }
+        }
+    }
+    else
+    {
+        WhoListBucketMap::const_iterator end = m_levelBuckets.upper_bound(query.levelMax);
+        for (WhoListBucketMap::const_iterator itr = m_levelBuckets.lower_bound(query.levelMin); itr != end; ++itr)
+        {
+            candidates.push_back(&itr->second);
+        }
+    }
+
+    for (std::vector<WhoListBucket const*>::const_iterator bucket = candidates.begin(); bucket != candidates.end() && clientcount < MAX_WHO_LIST_RESULTS; ++bucket)
+    {
+        for (WhoListBucket::const_iterator itr = (*bucket)->begin(); itr != (*bucket)->end() && clientcount < MAX_WHO_LIST_RESULTS; ++itr)
+        {
+            WhoListEntry const& entry = *itr->second;
+            if (!IsMatching(entry, query, session))
+            {
+                continue;
+            }
+
+            data << entry.name;                             // player name
+            data << entry.guildName;                        // guild name
+            data << uint32(entry.level);                    // player level
+            data << uint32(entry.class_);                   // player class
+            data << uint32(entry.race);                     // player race
+            data << uint8(entry.gender);                    // player gender
+            data << uint32(entry.zoneId);                   // player zone id
+
+            ++clientcount;
+        }
+    }
+
+    uint32 count = m_entries.size();
+    data.put(0, clientcount);                               // insert right count, listed count
+    data.put(4, count > MAX_WHO_LIST_RESULTS ? count : clientcount); // insert right count, online count
+
+    if (useCache && m_cache.size() < MAX_WHO_LIST_CACHE_SIZE)
+    {
+        WhoListCacheEntry& cached = m_cache[query];
+        cached.buildTime = getMSTime();
+        cached.packet.Initialize(SMSG_WHO, data.size());
+        cached.packet.append(data);
+    }
+}
+
+void WhoListMgr::RemoveExpiredResults(uint32 cacheTime)
+{
+    uint32 curTime = getMSTime();
+    for (WhoListCache::iterator itr = m_cache.begin(); itr != m_cache.end();)
+    {
+        if (getMSTimeDiff(itr->second.buildTime, curTime) >= cacheTime)
+        {
+            m_cache.erase(itr++);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
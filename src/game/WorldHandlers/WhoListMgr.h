@@ -0,0 +1,121 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_WHOLISTMGR
+#define MANGOS_H_WHOLISTMGR
+
+#include "Common.h"
+#include "SharedDefines.h"
+#include "Policies/Singleton.h"
+#include "WorldPacket.h"
+
+class Player;
+class WorldSession;
+
+/**
+ * Filters of a CMSG_WHO request, names and strings already lower case.
+ * Team and locale are part of it because they change the result for the same filters.
+ */
+struct WhoListQuery
+{
+    uint32 levelMin;
+    uint32 levelMax;
+    uint32 raceMask;
+    uint32 classMask;
+    std::vector<uint32> zoneIds;                            // empty for any
+    std::wstring playerName;                                // empty for any
+    std::wstring guildName;                                 // empty for any
+    std::vector<std::wstring> strings;                      // match guild, player or zone name
+    uint32 team;                                            // 0 if both teams are listed
+    uint32 locale;                                          // zone names are matched in the dbc locale
+
+    bool operator<(WhoListQuery const& other) const;
+};
+
+/**
+ * Online player as seen by /who, names normalized once instead of for every request.
+ */
+struct WhoListEntry
+{
+    Player* player;
+    std::string name;
+    std::wstring wname;                                     // lower case
+    std::string guildName;
+    std::wstring wguildName;                                // lower case
+    uint32 level;
+    uint32 zoneId;
+    uint8 race;
+    uint8 class_;
+    uint8 gender;
+    Team team;
+};
+
+/**
+ * Keeps the online players bucketed by level and zone, so a /who request only looks at
+ * players which can match. Kept up to date at login, logout, level, zone and guild changes.
+ * Only used from the world thread.
+ */
+class WhoListMgr
+{
+    public:
+        WhoListMgr() {}
+
+        void AddPlayer(Player* player);
+        void RemovePlayer(Player* player);
+        void UpdateLevel(Player* player);
+        void UpdateZone(Player* player, uint32 zoneId);
+        void UpdateGuild(Player* player);
+
+        /// Build the SMSG_WHO answer, identical requests of players share the result for WhoList.CacheTime
+        void BuildWhoList(WhoListQuery const& query, WorldSession* session, WorldPacket& data);
+
+        uint32 GetCount() const { return m_entries.size(); }
+
+    private:
+        typedef std::unordered_map<uint32, WhoListEntry> WhoListEntryMap;     // by guid low
+        typedef std::map<uint32, WhoListEntry*> WhoListBucket;                // by guid low, keeps the list order stable
+        typedef std::map<uint32, WhoListBucket> WhoListBucketMap;
+
+        struct WhoListCacheEntry
+        {
+            uint32 buildTime;
+            WorldPacket packet;
+        };
+
+        typedef std::map<WhoListQuery, WhoListCacheEntry> WhoListCache;
+
+        static void AddToBucket(WhoListBucketMap& buckets, uint32 key, WhoListEntry* entry);
+        static void RemoveFromBucket(WhoListBucketMap& buckets, uint32 key, WhoListEntry* entry);
+        static bool IsMatching(WhoListEntry const& entry, WhoListQuery const& query, WorldSession* session);
+        void RemoveExpiredResults(uint32 cacheTime);
+
+        WhoListEntryMap m_entries;
+        WhoListBucketMap m_levelBuckets;
+        WhoListBucketMap m_zoneBuckets;
+        WhoListCache m_cache;
+};
+
+#define sWhoListMgr MaNGOS::Singleton<WhoListMgr>::Instance()
+
+#endif
@@ -82,6 +82,8 @@
 #include "GitRevision.h"
 #include "UpdateTime.h"
 #include "GameTime.h"
+#include "OpcodeStats.h"
+#include "TickProfiler.h"
 
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
@@ -134,6 +136,7 @@ World::World(): mail_timer(0), mail_timer_expires(0), m_NextMonthlyQuestReset(0)
     m_broadcastEnable = false;
     m_broadcastList.clear();
     m_broadcastWeight = 0;
+    m_tickProfile = NULL;
 
     m_defaultDbcLocale = LOCALE_enUS;
     m_availableDbcLocaleMask = 0;
@@ -185,6 +188,8 @@ World::~World()
         delete session;
     }
 
+    delete m_tickProfile;
+
     VMAP::VMapFactory::clear();
     MMAP::MMapFactory::clear();
 }
@@ -552,6 +557,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_FLOAT_RATE_AUCTION_DEPOSIT, "Rate.Auction.Deposit", 1.0f);
     setConfig(CONFIG_FLOAT_RATE_AUCTION_CUT,     "Rate.Auction.Cut", 1.0f);
     setConfig(CONFIG_UINT32_AUCTION_DEPOSIT_MIN, "Auction.Deposit.Min", SILVER);
+    setConfig(CONFIG_UINT32_AUCTION_SEARCH_CACHE_TIME, "Auction.SearchCacheTime", 5 * IN_MILLISECONDS);
     setConfig(CONFIG_FLOAT_RATE_HONOR, "Rate.Honor", 1.0f);
     setConfigPos(CONFIG_FLOAT_RATE_MINING_AMOUNT, "Rate.Mining.Amount", 1.0f);
     setConfigPos(CONFIG_FLOAT_RATE_MINING_NEXT,   "Rate.Mining.Next", 1.0f);
@@ -583,6 +589,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
     setConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS, "MaxWhoListReturns", 49);
+    setConfig(CONFIG_UINT32_WHO_LIST_CACHE_TIME, "WhoList.CacheTime", 1 * IN_MILLISECONDS);
 
     setConfig(CONFIG_UINT32_AUTOBROADCAST_INTERVAL, "AutoBroadcast", 600);
 
@@ -612,6 +619,7 @@ void World::LoadConfigSettings(bool reload)
     }
 
     setConfig(CONFIG_UINT32_INTERVAL_SAVE, "PlayerSave.Interval", 15 * MINUTE * IN_MILLISECONDS);
+    setConfigMinMax(CONFIG_UINT32_INTERVAL_SAVE_SPREAD, "PlayerSave.Spread", 20, 0, 50);
     setConfigMinMax(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE, "PlayerSave.Stats.MinLevel", 0, 0, MAX_LEVEL);
     setConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT, "PlayerSave.Stats.SaveOnlyOnLogout", true);
 
@@ -769,7 +777,18 @@ void World::LoadConfigSettings(bool reload)
         setConfig(CONFIG_UINT32_MAX_OVERSPEED_PINGS, 2);
     }
 
+    setConfig(CONFIG_UINT32_MAX_PACKETS_PER_SECOND, "MaxPacketsPerSecond", 0);
+    setConfig(CONFIG_UINT32_MAX_PACKET_FLOOD_SECONDS, "MaxPacketFloodSeconds", 5);
+
+    setConfig(CONFIG_BOOL_TICK_PROFILER, "TickProfiler.Enable", false);
+    setConfig(CONFIG_UINT32_TICK_PROFILER_SPIKE_THRESHOLD, "TickProfiler.SpikeThreshold", 0);
+
+    setConfig(CONFIG_BOOL_OPCODE_STATS, "OpcodeStats.Enable", false);
+    setConfig(CONFIG_UINT32_OPCODE_STATS_SNAPSHOT_INTERVAL, "OpcodeStats.SnapshotInterval", 300);
+    sOpcodeStats.SetSnapshotFile(sConfig.GetStringDefault("OpcodeStats.SnapshotFile", "OpcodeStats.log"));
+
     setConfig(CONFIG_BOOL_SAVE_RESPAWN_TIME_IMMEDIATELY, "SaveRespawnTimeImmediately", true);
+    setConfig(CONFIG_UINT32_INTERVAL_SAVE_RESPAWN_TIME, "SaveRespawnTimeInterval", 10);
     setConfig(CONFIG_BOOL_WEATHER, "ActivateWeather", true);
 
     if (configNoReload(reload, CONFIG_UINT32_EXPANSION, "Expansion", MAX_EXPANSION))
@@ -979,6 +998,9 @@ void World::LoadConfigSettings(bool reload)
         m_MaxVisibleDistanceInFlight = MAX_VISIBILITY_DISTANCE - m_VisibleObjectGreyDistance;
     }
 
+    setConfigMinMax(CONFIG_FLOAT_MOVEMENT_BROADCAST_FULL_RATE_DISTANCE, "Visibility.MovementBroadcast.FullRate", 40.0f, 0.0f, MAX_VISIBILITY_DISTANCE);
+    setConfigMinMax(CONFIG_FLOAT_MOVEMENT_BROADCAST_HALF_RATE_DISTANCE, "Visibility.MovementBroadcast.HalfRate", 70.0f, getConfig(CONFIG_FLOAT_MOVEMENT_BROADCAST_FULL_RATE_DISTANCE), MAX_VISIBILITY_DISTANCE);
+
     ///- Load the CharDelete related config options
     setConfigMinMax(CONFIG_UINT32_CHARDELETE_METHOD, "CharDelete.Method", 0, 0, 1);
     setConfigMinMax(CONFIG_UINT32_CHARDELETE_MIN_LEVEL, "CharDelete.MinLevel", 0, 0, getConfig(CONFIG_UINT32_MAX_PLAYER_LEVEL));
@@ -1034,12 +1056,15 @@ void World::LoadConfigSettings(bool reload)
 
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableLineOfSightCalc(enableLOS);
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
+    VMAP::VMapFactory::createOrGetVMapManager()->setModelCacheSize(sConfig.GetIntDefault("vmap.modelCacheSize", 512));
     VMAP::VMapFactory::preventSpellsFromBeingTestedForLoS(ignoreSpellIds.c_str());
+    setConfig(CONFIG_UINT32_LOS_CACHE_SIZE, "vmap.losCacheSize", 1024);
     sLog.outString("WORLD: VMap support included. LineOfSight:%i, getHeight:%i, indoorCheck:%i",
                    enableLOS, enableHeight, getConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK) ? 1 : 0);
     sLog.outString("WORLD: VMap data directory is: %svmaps", m_dataPath.c_str());
 
     setConfig(CONFIG_BOOL_MMAP_ENABLED, "mmap.enabled", true);
+    setConfig(CONFIG_UINT32_MMAP_PATH_CACHE_SIZE, "mmap.pathCacheSize", 64);
     std::string ignoreMapIds = sConfig.GetStringDefault("mmap.ignoreMapIds", "");
     MMAP::MMapFactory::preventPathfindingOnMaps(ignoreMapIds.c_str());
     sLog.outString("WORLD: MMap pathfinding %sabled", getConfig(CONFIG_BOOL_MMAP_ENABLED) ? "en" : "dis");
@@ -1566,6 +1591,7 @@ void World::SetInitialWorldSettings()
     // Update "uptime" table based on configuration entry in minutes.
     m_timers[WUPDATE_CORPSES].SetInterval(20 * MINUTE * IN_MILLISECONDS);
     m_timers[WUPDATE_DELETECHARS].SetInterval(DAY * IN_MILLISECONDS); // check for chars to delete every day
+    m_timers[WUPDATE_OPCODE_STATS].SetInterval(getConfig(CONFIG_UINT32_OPCODE_STATS_SNAPSHOT_INTERVAL) * IN_MILLISECONDS);
 
     // for AhBot
     m_timers[WUPDATE_AHBOT].SetInterval(20 * IN_MILLISECONDS); // every 20 sec
@@ -1605,6 +1631,7 @@ void World::SetInitialWorldSettings()
     ///- Initialize MapManager
     sLog.outString("Starting Map System");
     sMapMgr.Initialize();
+    sTerrainMgr.PreloadTerrain(sConfig.GetStringDefault("Instance.PreloadMaps", "").c_str());
     sLog.outString();
 
     ///- Initialize Battlegrounds
@@ -1842,6 +1869,20 @@ void World::DetectDBCLang()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    // the clock is only read while profiling, the phase timers do nothing without a profile
+    TickProfile* tickProfile = NULL;
+    std::chrono::steady_clock::time_point tickStart;
+    if (getConfig(CONFIG_BOOL_TICK_PROFILER))
+    {
+        if (!m_tickProfile)
+        {
+            m_tickProfile = new TickProfile(MAX_WORLD_TICK_PHASES);
+        }
+
+        tickProfile = m_tickProfile;
+        tickStart = std::chrono::steady_clock::now();
+    }
+
     ///- Update the different timers
     for (int i = 0; i < WUPDATE_COUNT; ++i)
     {
@@ -1912,7 +1953,10 @@ void World::Update(uint32 diff)
     }
 
     /// <li> Handle session updates
-    UpdateSessions(diff);
+    {
+        TickPhaseTimer phaseTimer(tickProfile, WORLD_TICK_SESSIONS);
+        UpdateSessions(diff);
+    }
 
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
@@ -1926,9 +1970,20 @@ void World::Update(uint32 diff)
 
     /// <li> Handle all other objects
     ///- Update objects (maps, transport, creatures,...)
-    sMapMgr.Update(diff);
-    sBattleGroundMgr.Update(diff);
-    sOutdoorPvPMgr.Update(diff);
+    {
+        TickPhaseTimer phaseTimer(tickProfile, WORLD_TICK_MAPS);
+        sMapMgr.Update(diff);
+    }
+
+    {
+        TickPhaseTimer phaseTimer(tickProfile, WORLD_TICK_BATTLEGROUNDS);
+        sBattleGroundMgr.Update(diff);
+    }
+
+    {
+        TickPhaseTimer phaseTimer(tickProfile, WORLD_TICK_OUTDOORPVP);
+        sOutdoorPvPMgr.Update(diff);
+    }
 
     ///- Used by Eluna
 #ifdef ENABLE_ELUNA
@@ -1946,8 +2001,18 @@ void World::Update(uint32 diff)
         Player::DeleteOldCharacters();
     }
 
+    ///- Write the opcode handler stats snapshot
+    if (getConfig(CONFIG_BOOL_OPCODE_STATS) && getConfig(CONFIG_UINT32_OPCODE_STATS_SNAPSHOT_INTERVAL) && m_timers[WUPDATE_OPCODE_STATS].Passed())
+    {
+        m_timers[WUPDATE_OPCODE_STATS].Reset();
+        sOpcodeStats.WriteSnapshot();
+    }
+
     // execute callbacks from sql queries that were queued recently
-    UpdateResultQueue();
+    {
+        TickPhaseTimer phaseTimer(tickProfile, WORLD_TICK_RESULT_QUEUE);
+        UpdateResultQueue();
+    }
 
     ///- Erase corpses once every 20 minutes
     if (m_timers[WUPDATE_CORPSES].Passed())
@@ -1968,16 +2033,78 @@ void World::Update(uint32 diff)
 
     /// </ul>
     ///- Move all creatures with "delayed move" and remove and delete all objects with "delayed remove"
-    sMapMgr.RemoveAllObjectsInRemoveList();
+    {
+        TickPhaseTimer phaseTimer(tickProfile, WORLD_TICK_REMOVE_LIST);
+        sMapMgr.RemoveAllObjectsInRemoveList();
+    }
 
     // update the instance reset times
     sMapPersistentStateMgr.Update();
 
     // And last, but not least handle the issued cli commands
-    ProcessCliCommands();
+    {
+        TickPhaseTimer phaseTimer(tickProfile, WORLD_TICK_CLI_COMMANDS);
+        ProcessCliCommands();
+    }
 
     // cleanup unused GridMap objects as well as VMaps
     sTerrainMgr.Update(diff);
+
+    if (tickProfile)
+    {
+        uint32 tickTime = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tickStart).count());
+        tickProfile->AddSample(WORLD_TICK_TOTAL, tickTime);
+
+        uint32 spikeThreshold = getConfig(CONFIG_UINT32_TICK_PROFILER_SPIKE_THRESHOLD);
+        if (spikeThreshold && tickTime > spikeThreshold * IN_MILLISECONDS)
+        {
+            ReportTickSpike(tickTime);
+        }
+    }
+}
+
+/// Log which world phases and which maps took the time of a slow tick
+void World::ReportTickSpike(uint32 tickTime)
+{
+    sLog.outString("Tick spike: world update took %u ms, players online: %u", tickTime / IN_MILLISECONDS, GetActiveSessionCount());
+
+    TickPhaseStats stats;
+    for (uint32 phase = 0; phase < WORLD_TICK_TOTAL; ++phase)
+    {
+        m_tickProfile->GetStats(phase, stats);
+        sLog.outString("    %-14s %8u us (p50 %u us, p99 %u us)", GetWorldTickPhaseName(phase), stats.last, stats.p50, stats.p99);
+    }
+
+    // maps are listed slowest first, only those which took a noticeable part of the tick
+    std::vector<std::pair<uint32, Map const*> > slowMaps;
+    for (MapManager::MapMapType::const_iterator itr = sMapMgr.Maps().begin(); itr != sMapMgr.Maps().end(); ++itr)
+    {
+        if (TickProfile const* mapProfile = itr->second->GetTickProfile())
+        {
+            mapProfile->GetStats(MAP_TICK_TOTAL, stats);
+            if (stats.last >= tickTime / 10)
+            {
+                slowMaps.push_back(std::make_pair(stats.last, itr->second));
+            }
+        }
+    }
+
+    std::sort(slowMaps.begin(), slowMaps.end(), [](std::pair<uint32, Map const*> const& a, std::pair<uint32, Map const*> const& b)
+    {
+        return a.first > b.first;
+    });
+
+    for (std::vector<std::pair<uint32, Map const*> >::const_iterator itr = slowMaps.begin(); itr != slowMaps.end(); ++itr)
+    {
+        Map const* map = itr->second;
+        sLog.outString("    map %u (%s) instance %u: %u us, players: %u", map->GetId(), map->GetMapName(), map->GetInstanceId(), itr->first, map->GetPlayersCountExceptGMs());
+
+        for (uint32 phase = 0; phase < MAP_TICK_TOTAL; ++phase)
+        {
+            map->GetTickProfile()->GetStats(phase, stats);
+            sLog.outString("        %-14s %8u us (p50 %u us, p99 %u us)", GetMapTickPhaseName(phase), stats.last, stats.p50, stats.p99);
+        }
+    }
 }
 
 namespace MaNGOS
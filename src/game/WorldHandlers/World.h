@@ -51,6 +51,7 @@ class Weather;
 class SqlResultQueue;
 class QueryResult;
 class WorldSocket;
+class TickProfile;
 
 // ServerMessages.dbc
 enum ServerMessageType
@@ -90,7 +91,8 @@ enum WorldTimers
     WUPDATE_AHBOT       = 5,
     WUPDATE_LFGMGR      = 6,
     WUPDATE_WEATHERS    = 7,
-    WUPDATE_COUNT       = 8
+    WUPDATE_OPCODE_STATS = 8,
+    WUPDATE_COUNT       = 9
 };
 
 /// Configuration elements
@@ -111,6 +113,8 @@ enum eConfigUInt32Values
 {
     CONFIG_UINT32_COMPRESSION = 0,
     CONFIG_UINT32_INTERVAL_SAVE,
+    CONFIG_UINT32_INTERVAL_SAVE_SPREAD,
+    CONFIG_UINT32_INTERVAL_SAVE_RESPAWN_TIME,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
@@ -167,6 +171,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
+    CONFIG_UINT32_AUCTION_SEARCH_CACHE_TIME,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
     CONFIG_UINT32_SKILL_CHANCE_YELLOW,
     CONFIG_UINT32_SKILL_CHANCE_GREEN,
@@ -176,6 +181,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_SKILL_GAIN_CRAFTING,
     CONFIG_UINT32_SKILL_GAIN_GATHERING,
     CONFIG_UINT32_MAX_OVERSPEED_PINGS,
+    CONFIG_UINT32_MAX_PACKETS_PER_SECOND,
+    CONFIG_UINT32_MAX_PACKET_FLOOD_SECONDS,
     CONFIG_UINT32_EXPANSION,
     CONFIG_UINT32_CHATFLOOD_MESSAGE_COUNT,
     CONFIG_UINT32_CHATFLOOD_MESSAGE_DELAY,
@@ -225,7 +232,12 @@ enum eConfigUInt32Values
     CONFIG_UINT32_CREATURE_RESPAWN_AGGRO_DELAY,
     CONFIG_UINT32_RANDOM_BG_RESET_HOUR,
     CONFIG_UINT32_MAX_WHOLIST_RETURNS,
+    CONFIG_UINT32_WHO_LIST_CACHE_TIME,
     CONFIG_UINT32_LOG_WHISPERS,
+    CONFIG_UINT32_MMAP_PATH_CACHE_SIZE,
+    CONFIG_UINT32_LOS_CACHE_SIZE,
+    CONFIG_UINT32_OPCODE_STATS_SNAPSHOT_INTERVAL,
+    CONFIG_UINT32_TICK_PROFILER_SPIKE_THRESHOLD,
 
     // Warden
     CONFIG_UINT32_WARDEN_CLIENT_RESPONSE_DELAY,
@@ -327,6 +339,8 @@ enum eConfigFloatValues
     CONFIG_FLOAT_THREAT_RADIUS,
     CONFIG_FLOAT_GHOST_RUN_SPEED_WORLD,
     CONFIG_FLOAT_GHOST_RUN_SPEED_BG,
+    CONFIG_FLOAT_MOVEMENT_BROADCAST_FULL_RATE_DISTANCE,
+    CONFIG_FLOAT_MOVEMENT_BROADCAST_HALF_RATE_DISTANCE,
     CONFIG_FLOAT_VALUE_COUNT
 };
 
@@ -398,6 +412,8 @@ enum eConfigBoolValues
     CONFIG_BOOL_PLAYER_COMMANDS,
     CONFIG_BOOL_GUILD_LEVELING_ENABLED,
     CONFIG_BOOL_ENABLE_QUEST_TRACKER,
+    CONFIG_BOOL_OPCODE_STATS,
+    CONFIG_BOOL_TICK_PROFILER,
 
     // Warden
     CONFIG_BOOL_WARDEN_WIN_ENABLED,
@@ -561,6 +577,9 @@ class World
         /// Get the path where data (dbc, maps) are stored on disk
         std::string GetDataPath() const { return m_dataPath; }
 
+        /// Per phase update times, NULL until TickProfiler.Enable is set
+        TickProfile const* GetTickProfile() const { return m_tickProfile; }
+
         /// When server started?
         time_t const& GetStartTime() const { return m_startTime; }
         /// What time is it?
@@ -660,6 +679,8 @@ class World
         void UpdateResultQueue();
         void InitResultQueue();
 
+        void ReportTickSpike(uint32 tickTime);
+
         void UpdateRealmCharCount(uint32 accid);
 
         LocaleConstant GetAvailableDbcLocale(LocaleConstant locale) const { if (m_availableDbcLocaleMask & (1 << locale)) { return locale; } else { return m_defaultDbcLocale; } }
@@ -745,6 +766,7 @@ class World
         time_t m_startTime;
         time_t m_gameTime;
         IntervalTimer m_timers[WUPDATE_COUNT];
+        TickProfile* m_tickProfile;
         uint32 mail_timer;
         uint32 mail_timer_expires;
 
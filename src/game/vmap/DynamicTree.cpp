@@ -87,11 +87,11 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
         unbalanced_times = 0;
     }
 
-    void update(uint32 difftime)
+    bool update(uint32 difftime)
     {
         if (!size())
         {
-            return;
+            return false;
         }
 
         rebalance_timer.Update(difftime);
@@ -101,8 +101,11 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
             if (unbalanced_times > 0)
             {
                 balance();
+                return true;
             }
         }
+
+        return false;
     }
 
     TimeTracker rebalance_timer;
@@ -143,9 +146,9 @@ int DynamicMapTree::size() const
     return impl.size();
 }
 
-void DynamicMapTree::update(uint32 t_diff)
+bool DynamicMapTree::update(uint32 t_diff)
 {
-    impl.update(t_diff);
+    return impl.update(t_diff);
 }
 
 struct DynamicTreeIntersectionCallback
@@ -147,8 +147,9 @@ class DynamicMapTree
          * @brief
          *
          * @param diff
+         * @return bool true if the tree was rebalanced, models inserted since then are hit by rays now
          */
-        void update(uint32 diff);
+        bool update(uint32 diff);
     private:
         struct DynTreeImpl& impl; /**< TODO */
 };
@@ -104,6 +104,12 @@ class GameObjectModel
          * @param enabled
          */
         void enable(uint32 ph_mask) { phasemask = ph_mask;}
+        /**
+         * @brief
+         *
+         * @return uint32 phases the model collides in, 0 if disabled
+         */
+        uint32 GetPhaseMask() const { return phasemask; }
 
         /**
          * @brief
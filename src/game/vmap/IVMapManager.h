@@ -60,13 +60,14 @@ namespace VMAP
         private:
             bool iEnableLineOfSightCalc; /**< TODO */
             bool iEnableHeightCalc; /**< TODO */
+            unsigned int iModelCacheSize; /**< models kept loaded after their last spawn is unloaded */
 
         public:
             /**
              * @brief
              *
              */
-            IVMapManager() : iEnableLineOfSightCalc(true), iEnableHeightCalc(true) {}
+            IVMapManager() : iEnableLineOfSightCalc(true), iEnableHeightCalc(true), iModelCacheSize(0) {}
 
             /**
              * @brief
@@ -177,6 +178,19 @@ namespace VMAP
              * @param pVal
              */
             void setEnableHeightCalc(bool pVal) { iEnableHeightCalc = pVal; }
+            /**
+             * @brief Number of unreferenced models kept loaded, so tiles and instances loading them
+             *        again do not have to read and parse the model file again
+             *
+             * @param pVal
+             */
+            void setModelCacheSize(unsigned int pVal) { iModelCacheSize = pVal; }
+            /**
+             * @brief
+             *
+             * @return unsigned int
+             */
+            unsigned int getModelCacheSize() const { return iModelCacheSize; }
 
             /**
              * @brief
@@ -287,6 +287,11 @@ namespace VMAP
             model = iLoadedModelFiles.insert(std::pair<std::string, ManagedModel>(filename, ManagedModel())).first;
             model->second.setModel(worldmodel);
         }
+        else if (model->second.getRefCount() == 0)
+        {
+            // kept loaded after its last release
+            iUnusedModels.erase(model->second.iUnusedPos);
+        }
         model->second.incRefCount();
         return model->second.getModel();
     }
@@ -301,9 +306,17 @@ namespace VMAP
         }
         if (model->second.decRefCount() == 0)
         {
-            DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "VMapManager2: unloading file '%s'", filename.c_str());
-            delete model->second.getModel();
-            iLoadedModelFiles.erase(model);
+            model->second.iUnusedPos = iUnusedModels.insert(iUnusedModels.end(), filename);
+
+            // unload the models released longest ago
+            while (iUnusedModels.size() > getModelCacheSize())
+            {
+                ModelFileMap::iterator unused = iLoadedModelFiles.find(iUnusedModels.front());
+                DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "VMapManager2: unloading file '%s'", unused->first.c_str());
+                delete unused->second.getModel();
+                iLoadedModelFiles.erase(unused);
+                iUnusedModels.pop_front();
+            }
         }
     }
     //=========================================================
@@ -29,6 +29,7 @@
 #include "Platform/Define.h"
 #include <G3D/Vector3.h>
 
+#include <list>
 #include <unordered_map>
 
 //===========================================================
@@ -52,6 +53,12 @@ namespace VMAP
     class StaticMapTree;
     class WorldModel;
 
+    /**
+     * @brief file names of the loaded models without references, least recently released first
+     *
+     */
+    typedef std::list<std::string> UnusedModelList;
+
     /**
      * @brief
      *
@@ -87,6 +94,14 @@ namespace VMAP
              * @return int
              */
             int decRefCount() { return --iRefCount; }
+            /**
+             * @brief
+             *
+             * @return int
+             */
+            int getRefCount() const { return iRefCount; }
+
+            UnusedModelList::iterator iUnusedPos; /**< position in the unused list, valid while the ref count is 0 */
         protected:
             WorldModel* iModel; /**< TODO */
             int iRefCount; /**< TODO */
@@ -120,6 +135,7 @@ namespace VMAP
         protected:
             // Tree to check collision
             ModelFileMap iLoadedModelFiles; /**< TODO */
+            UnusedModelList iUnusedModels; /**< TODO */
             InstanceTreeMap iInstanceMapTrees; /**< TODO */
 
             /**
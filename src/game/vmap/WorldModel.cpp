@@ -41,14 +41,14 @@ template<> struct BoundsTrait<VMAP::GroupModel>
 
 namespace VMAP
 {
-    bool IntersectTriangle(const MeshTriangle& tri, std::vector<Vector3>::const_iterator points, const G3D::Ray& ray, float& distance)
+    bool IntersectTriangle(const MeshTriangleEdges& tri, const G3D::Ray& ray, float& distance)
     {
         static const float EPS = 1e-5f;
 
         // See RTR2 ch. 13.7 for the algorithm.
 
-        const Vector3 e1 = points[tri.idx1] - points[tri.idx0];
-        const Vector3 e2 = points[tri.idx2] - points[tri.idx0];
+        const Vector3& e1 = tri.e1;
+        const Vector3& e2 = tri.e2;
         const Vector3 p(ray.direction().cross(e2));
         const float a = e1.dot(p);
 
@@ -59,7 +59,7 @@ namespace VMAP
         }
 
         const float f = 1.0f / a;
-        const Vector3 s(ray.origin() - points[tri.idx0]);
+        const Vector3 s(ray.origin() - tri.v0);
         const float u = f * s.dot(p);
 
         if ((u < 0.0f) || (u > 1.0f))
@@ -309,7 +309,7 @@ namespace VMAP
 
     GroupModel::GroupModel(const GroupModel& other):
         iBound(other.iBound), iMogpFlags(other.iMogpFlags), iGroupWMOID(other.iGroupWMOID),
-        vertices(other.vertices), triangles(other.triangles), meshTree(other.meshTree), iLiquid(0)
+        vertices(other.vertices), triangles(other.triangles), triangleEdges(other.triangleEdges), meshTree(other.meshTree), iLiquid(0)
     {
         if (other.iLiquid)
         {
@@ -323,6 +323,20 @@ namespace VMAP
         triangles.swap(tri);
         TriBoundFunc bFunc(vertices);
         meshTree.build(triangles, bFunc);
+        BuildTriangleEdges();
+    }
+
+    void GroupModel::BuildTriangleEdges()
+    {
+        triangleEdges.resize(triangles.size());
+        for (uint32 i = 0; i < triangles.size(); ++i)
+        {
+            const MeshTriangle& tri = triangles[i];
+            MeshTriangleEdges& edges = triangleEdges[i];
+            edges.v0 = vertices[tri.idx0];
+            edges.e1 = vertices[tri.idx1] - vertices[tri.idx0];
+            edges.e2 = vertices[tri.idx2] - vertices[tri.idx0];
+        }
     }
 
     bool GroupModel::WriteToFile(FILE* wf)
@@ -424,6 +438,7 @@ namespace VMAP
         uint32 chunkSize = 0;
         uint32 count =0;
         triangles.clear();
+        triangleEdges.clear();
         vertices.clear();
         delete iLiquid;
         iLiquid = 0;
@@ -501,6 +516,10 @@ namespace VMAP
         {
             result = meshTree.ReadFromFile(rf);
         }
+        if (result)
+        {
+            BuildTriangleEdges();
+        }
 
         // read liquid data
         if (result && !readChunk(rf, chunk, "LIQU", 4))
@@ -520,19 +539,17 @@ namespace VMAP
 
     struct GModelRayCallback
     {
-        GModelRayCallback(const std::vector<MeshTriangle>& tris, const std::vector<Vector3>& vert):
-            vertices(vert.begin()), triangles(tris.begin()), hit(false) {}
+        GModelRayCallback(const std::vector<MeshTriangleEdges>& tris): triangles(tris.begin()), hit(false) {}
         bool operator()(const G3D::Ray& ray, uint32 entry, float& distance, bool /*pStopAtFirstHit*/)
         {
-            bool result = IntersectTriangle(triangles[entry], vertices, ray, distance);
+            bool result = IntersectTriangle(triangles[entry], ray, distance);
             if (result)
             {
                 hit = true;
             }
             return hit;
         }
-        std::vector<Vector3>::const_iterator vertices;
-        std::vector<MeshTriangle>::const_iterator triangles;
+        std::vector<MeshTriangleEdges>::const_iterator triangles;
         bool hit;
     };
 
@@ -542,7 +559,7 @@ namespace VMAP
         {
             return false;
         }
-        GModelRayCallback callback(triangles, vertices);
+        GModelRayCallback callback(triangleEdges);
         meshTree.IntersectRay(ray, callback, distance, stopAtFirstHit);
         return callback.hit;
     }
@@ -553,7 +570,7 @@ namespace VMAP
         {
             return false;
         }
-        GModelRayCallback callback(triangles, vertices);
+        GModelRayCallback callback(triangleEdges);
         Vector3 rPos = pos - 0.1f * down;
         float dist = G3D::inf();
         G3D::Ray ray(rPos, down);
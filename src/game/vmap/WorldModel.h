@@ -65,6 +65,18 @@ namespace VMAP
             uint32 idx2; /**< TODO */
     };
 
+    /**
+     * @brief first corner and the two edges of a MeshTriangle, precomputed at load time
+     *        so the ray test does not have to look up the vertices for every check
+     *
+     */
+    struct MeshTriangleEdges
+    {
+        Vector3 v0; /**< first corner */
+        Vector3 e1; /**< second corner - first corner */
+        Vector3 e2; /**< third corner - first corner */
+    };
+
     /**
      * @brief
      *
@@ -280,9 +292,16 @@ namespace VMAP
             uint32 iGroupWMOID; /**< TODO */
             std::vector<Vector3> vertices; /**< TODO */
             std::vector<MeshTriangle> triangles; /**< TODO */
+            std::vector<MeshTriangleEdges> triangleEdges; /**< same order as triangles, used for the ray tests */
             BIH meshTree; /**< TODO */
             WmoLiquid* iLiquid; /**< TODO */
 
+            /**
+             * @brief fill triangleEdges from the loaded mesh
+             *
+             */
+            void BuildTriangleEdges();
+
 #ifdef MMAP_GENERATOR
         public:
             void getMeshData(std::vector<Vector3>& vertices, std::vector<MeshTriangle>& triangles, WmoLiquid*& liquid);
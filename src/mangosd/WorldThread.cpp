@@ -34,6 +34,7 @@
 #include "Timer.h"
 #include "ObjectAccessor.h"
 #include "MapManager.h"
+#include "MapPersistentStateMgr.h"
 #include "Database/DatabaseEnv.h"
 
 #include <chrono>
@@ -108,6 +109,7 @@ int WorldThread::svc()
     sWorldSocketMgr->StopNetwork();
 
     sMapMgr.UnloadAll();                                    // unload all grids (including locked in memory)
+    sMapPersistentStateMgr.FlushRespawnTimes();             // write respawn times still buffered, including the ones saved at unload
 
     sLog.outString("World Updater Thread stopped");
     return 0;
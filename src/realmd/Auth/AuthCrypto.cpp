@@ -0,0 +1,208 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/** \file
+    \ingroup realmd
+*/
+
+#include "AuthCrypto.h"
+#include "AuthSocket.h"
+#include "Log.h"
+
+#include <ace/Singleton.h>
+#include <ace/Reactor.h>
+
+AuthCryptoPool* AuthCryptoPool::instance()
+{
+    return ACE_Singleton<AuthCryptoPool, ACE_Thread_Mutex>::instance();
+}
+
+AuthCryptoPool::AuthCryptoPool() : m_numThreads(0), m_maxQueued(0), m_queued(0), m_peakQueued(0), m_finished(0), m_rejected(0)
+{
+}
+
+AuthCryptoPool::~AuthCryptoPool()
+{
+    Stop();
+}
+
+void AuthCryptoPool::Start(ACE_Reactor* reactor, uint32 numThreads, uint32 maxQueued)
+{
+    this->reactor(reactor);
+    m_maxQueued = maxQueued;
+
+    if (numThreads && activate(THR_NEW_LWP | THR_JOINABLE, numThreads) == -1)
+    {
+        sLog.outError("Can not start crypto worker threads, SRP6 calculations are done on the network thread.");
+        numThreads = 0;
+    }
+
+    m_numThreads = numThreads;
+    if (m_numThreads)
+    {
+        sLog.outString("Started %u crypto worker thread(s), up to %u queued logins", m_numThreads, m_maxQueued);
+    }
+}
+
+void AuthCryptoPool::Stop()
+{
+    if (!m_numThreads)
+    {
+        return;
+    }
+
+    m_numThreads = 0;
+    m_queue.queue()->deactivate();
+    wait();
+
+    // sockets are going down with the reactor, results are not delivered anymore
+    // the workers are gone, reactivate the queue only to take out what they left behind
+    m_queue.queue()->activate();
+    while (!m_queue.is_empty())
+    {
+        DropTask(static_cast<AuthCryptoTask*>(m_queue.dequeue()));
+    }
+
+    std::vector<AuthCryptoTask*> completed;
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_completedLock);
+        completed.swap(m_completed);
+    }
+
+    for (std::vector<AuthCryptoTask*>::const_iterator itr = completed.begin(); itr != completed.end(); ++itr)
+    {
+        DropTask(*itr);
+    }
+
+    sLog.outString("Crypto workers stopped: %u tasks finished, peak queue %u, %u logins turned away", m_finished, m_peakQueued, m_rejected);
+}
+
+void AuthCryptoPool::DropTask(AuthCryptoTask* task)
+{
+    if (!task)
+    {
+        return;
+    }
+
+    --m_queued;
+
+    // the socket must not cancel the task in its destructor anymore
+    if (AuthSocket* socket = task->GetSocket())
+    {
+        socket->_DropCryptoTask();
+    }
+    delete task;
+}
+
+bool AuthCryptoPool::IsSaturated() const
+{
+    return IsActive() && m_maxQueued && m_queued >= m_maxQueued;
+}
+
+void AuthCryptoPool::Submit(AuthCryptoTask* task)
+{
+    if (!IsActive())
+    {
+        task->call();
+        if (AuthSocket* socket = task->GetSocket())
+        {
+            task->Finish(*socket);
+        }
+        delete task;
+        return;
+    }
+
+    ++m_queued;
+    if (m_queued > m_peakQueued)
+    {
+        m_peakQueued = m_queued;
+    }
+
+    m_queue.enqueue(task);
+}
+
+void AuthCryptoPool::Complete(AuthCryptoTask* task)
+{
+    bool wakeup;
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_completedLock);
+        wakeup = m_completed.empty();
+        m_completed.push_back(task);
+    }
+
+    // one notification is enough for everything collected until the reactor picks them up
+    if (wakeup)
+    {
+        reactor()->notify(this, ACE_Event_Handler::EXCEPT_MASK);
+    }
+}
+
+void AuthCryptoPool::CountRejected()
+{
+    if (++m_rejected % 100 == 1)
+    {
+        sLog.outError("Crypto queue is full (%u logins waiting), %u logins turned away so far", m_queued, m_rejected);
+    }
+}
+
+int AuthCryptoPool::svc()
+{
+    for (;;)
+    {
+        ACE_Method_Request* rq = m_queue.dequeue();
+
+        if (!rq)
+        {
+            break;
+        }
+
+        rq->call();
+        Complete(static_cast<AuthCryptoTask*>(rq));
+    }
+
+    return 0;
+}
+
+int AuthCryptoPool::handle_exception(ACE_HANDLE /*fd*/)
+{
+    std::vector<AuthCryptoTask*> completed;
+    {
+        ACE_Guard<ACE_Thread_Mutex> guard(m_completedLock);
+        completed.swap(m_completed);
+    }
+
+    for (std::vector<AuthCryptoTask*>::const_iterator itr = completed.begin(); itr != completed.end(); ++itr)
+    {
+        --m_queued;
+        ++m_finished;
+
+        if (AuthSocket* socket = (*itr)->GetSocket())
+        {
+            (*itr)->Finish(*socket);
+        }
+        delete *itr;
+    }
+
+    return 0;
+}
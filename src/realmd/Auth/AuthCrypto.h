@@ -0,0 +1,152 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/// \addtogroup realmd
+/// @{
+/// \file
+
+#ifndef MANGOS_H_AUTHCRYPTO
+#define MANGOS_H_AUTHCRYPTO
+
+#include "Common.h"
+
+#include <ace/Task.h>
+#include <ace/Activation_Queue.h>
+#include <ace/Method_Request.h>
+#include <ace/Thread_Mutex.h>
+
+#include <vector>
+
+class AuthSocket;
+
+/**
+ * @brief SRP6 work of one client, split off the reactor thread
+ *
+ * call() runs on a crypto worker and must only touch the task's own data,
+ * Finish() runs on the reactor thread and hands the result back to the socket.
+ */
+class AuthCryptoTask : public ACE_Method_Request
+{
+    public:
+        explicit AuthCryptoTask(AuthSocket* socket) : m_socket(socket) {}
+
+        /**
+         * @brief Hands the result back to the socket, reactor thread only
+         *
+         * @param socket
+         */
+        virtual void Finish(AuthSocket& socket) = 0;
+
+        /**
+         * @brief The socket was closed while the task was queued, its result is dropped
+         *
+         */
+        void Cancel() { m_socket = NULL; }
+        AuthSocket* GetSocket() const { return m_socket; }
+
+    private:
+        AuthSocket* m_socket;                               ///< Reactor thread only, never read by the workers
+};
+
+/**
+ * @brief Bounded pool of worker threads for the SRP6 calculations of realmd
+ *
+ * Finished tasks are collected and handed back through a reactor notification,
+ * so the socket state machine always continues on the reactor thread.
+ */
+class AuthCryptoPool : public ACE_Task_Base
+{
+    public:
+        AuthCryptoPool();
+        ~AuthCryptoPool();
+
+        static AuthCryptoPool* instance();
+
+        /**
+         * @brief Starts the workers, with 0 threads every task is computed on the reactor thread
+         *
+         * @param reactor
+         * @param numThreads
+         * @param maxQueued
+         */
+        void Start(ACE_Reactor* reactor, uint32 numThreads, uint32 maxQueued);
+        void Stop();
+        bool IsActive() const { return m_numThreads > 0; }
+
+        /**
+         * @brief True if new logins should be turned away until the queue drained
+         *
+         * @return bool
+         */
+        bool IsSaturated() const;
+
+        /**
+         * @brief Queues the task, the pool owns it from now on
+         *
+         * @param task
+         */
+        void Submit(AuthCryptoTask* task);
+
+        /**
+         * @brief Called by a worker when the task was computed
+         *
+         * @param task
+         */
+        void Complete(AuthCryptoTask* task);
+
+        /**
+         * @brief Counts a login turned away by IsSaturated()
+         *
+         */
+        void CountRejected();
+
+        int svc() override;
+        int handle_exception(ACE_HANDLE fd = ACE_INVALID_HANDLE) override;
+
+    private:
+        /**
+         * @brief Frees a task whose result is not delivered anymore, detaching it from its socket first
+         *
+         * @param task
+         */
+        void DropTask(AuthCryptoTask* task);
+
+        ACE_Activation_Queue m_queue;
+        uint32 m_numThreads;
+        uint32 m_maxQueued;
+
+        ACE_Thread_Mutex m_completedLock;
+        std::vector<AuthCryptoTask*> m_completed;           ///< Computed, waiting for the reactor thread
+
+        // statistics, reactor thread only
+        uint32 m_queued;                                    ///< Submitted but not finished yet
+        uint32 m_peakQueued;
+        uint32 m_finished;
+        uint32 m_rejected;
+};
+
+#define sAuthCryptoPool AuthCryptoPool::instance()
+
+#endif
+/// @}
@@ -33,6 +33,7 @@
 #include "Realm/RealmList.h"
 #include "AuthSocket.h"
 #include "AuthCodes.h"
+#include "AuthCrypto.h"
 #include "Patch/PatchHandler.h"
 
 #include <openssl/md5.h>
@@ -142,7 +143,7 @@ typedef struct AuthHandler
 
 
 /// Constructor - set the N and g values for SRP6
-AuthSocket::AuthSocket() : _status(STATUS_CHALLENGE), _accountSecurityLevel(SEC_PLAYER), _build(0), patch_(ACE_INVALID_HANDLE)
+AuthSocket::AuthSocket() : _status(STATUS_CHALLENGE), _accountSecurityLevel(SEC_PLAYER), _build(0), patch_(ACE_INVALID_HANDLE), _cryptoTask(NULL)
 {
     N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
     g.SetDword(7);
@@ -151,6 +152,12 @@ AuthSocket::AuthSocket() : _status(STATUS_CHALLENGE), _accountSecurityLevel(SEC_
 /// Close patch file descriptor before leaving
 AuthSocket::~AuthSocket()
 {
+    // the calculation can not be stopped, just make sure its result is not delivered to us
+    if (_cryptoTask)
+    {
+        _cryptoTask->Cancel();
+    }
+
     if (patch_ != ACE_INVALID_HANDLE)
     {
         ACE_OS::close(patch_);
@@ -183,6 +190,12 @@ void AuthSocket::OnRead()
 
     while (1)
     {
+        // the client waits for the answer of the running calculation, anything else it sent is handled after it
+        if (_cryptoTask)
+        {
+            return;
+        }
+
         if (!recv_soft((char*)&_cmd, 1))
         {
             return;
@@ -221,39 +234,202 @@ void AuthSocket::OnRead()
     }
 }
 
-/// Make the SRP6 calculation from hash in dB
-void AuthSocket::_SetVSFields(const std::string& rI)
+void AuthSocket::_StartCryptoTask(AuthCryptoTask* task)
 {
-    s.SetRand(s_BYTE_SIZE * 8);
+    // without workers the task is finished right away, inside the handler
+    if (sAuthCryptoPool->IsActive())
+    {
+        _cryptoTask = task;
+    }
+
+    sAuthCryptoPool->Submit(task);
+}
 
-    BigNumber I;
-    I.SetHexStr(rI.c_str());
+void AuthSocket::_DropCryptoTask()
+{
+    _cryptoTask = NULL;
+}
 
-    // In case of leading zeros in the rI hash, restore them
-    uint8 mDigest[SHA_DIGEST_LENGTH];
-    memset(mDigest, 0, SHA_DIGEST_LENGTH);
-    if (I.GetNumBytes() <= SHA_DIGEST_LENGTH)
+void AuthSocket::_ResumeAfterCrypto()
+{
+    if (_cryptoTask)
     {
-        memcpy(mDigest, I.AsByteArray(), I.GetNumBytes());
+        _cryptoTask = NULL;
+        OnRead();
     }
+}
+
+/// Logon challenge SRP6 calculation: the verifier (if the account has none yet) and the public value B
+class LogonChallengeTask : public AuthCryptoTask
+{
+    public:
+        LogonChallengeTask(AuthSocket* socket, BigNumber const& N, BigNumber const& g, std::string const& rI, std::string const& databaseV, std::string const& databaseS)
+            : AuthCryptoTask(socket), N(N), g(g), rI(rI), newVS(false)
+        {
+            // multiply with 2, bytes are stored as hexstring
+            if (databaseV.size() != AuthSocket::s_BYTE_SIZE * 2 || databaseS.size() != AuthSocket::s_BYTE_SIZE * 2)
+            {
+                newVS = true;
+            }
+            else
+            {
+                s.SetHexStr(databaseS.c_str());
+                v.SetHexStr(databaseV.c_str());
+            }
+        }
+
+        int call() override
+        {
+            ///- Make the SRP6 calculation from hash in dB
+            if (newVS)
+            {
+                s.SetRand(AuthSocket::s_BYTE_SIZE * 8);
 
-    std::reverse(mDigest, mDigest + SHA_DIGEST_LENGTH);
+                BigNumber I;
+                I.SetHexStr(rI.c_str());
 
-    Sha1Hash sha;
-    sha.UpdateData(s.AsByteArray(), s.GetNumBytes());
-    sha.UpdateData(mDigest, SHA_DIGEST_LENGTH);
-    sha.Finalize();
-    BigNumber x;
-    x.SetBinary(sha.GetDigest(), sha.GetLength());
-    v = g.ModExp(x, N);
-    // No SQL injection (username escaped)
-    const char* v_hex, *s_hex;
-    v_hex = v.AsHexStr();
-    s_hex = s.AsHexStr();
-    LoginDatabase.PExecute("UPDATE `account` SET `v` = '%s', `s` = '%s' WHERE `username` = '%s'", v_hex, s_hex, _safelogin.c_str());
-    OPENSSL_free((void*)v_hex);
-    OPENSSL_free((void*)s_hex);
-}
+                // In case of leading zeros in the rI hash, restore them
+                uint8 mDigest[SHA_DIGEST_LENGTH];
+                memset(mDigest, 0, SHA_DIGEST_LENGTH);
+                if (I.GetNumBytes() <= SHA_DIGEST_LENGTH)
+                {
+                    memcpy(mDigest, I.AsByteArray(), I.GetNumBytes());
+                }
+
+                std::reverse(mDigest, mDigest + SHA_DIGEST_LENGTH);
+
+                Sha1Hash sha;
+                sha.UpdateData(s.AsByteArray(), s.GetNumBytes());
+                sha.UpdateData(mDigest, SHA_DIGEST_LENGTH);
+                sha.Finalize();
+                BigNumber x;
+                x.SetBinary(sha.GetDigest(), sha.GetLength());
+                v = g.ModExp(x, N);
+            }
+
+            b.SetRand(19 * 8);
+            BigNumber gmod = g.ModExp(b, N);
+            B = ((v * 3) + gmod) % N;
+
+            MANGOS_ASSERT(gmod.GetNumBytes() <= 32);
+            return 0;
+        }
+
+        void Finish(AuthSocket& socket) override
+        {
+            socket._FinishLogonChallenge(s, v, newVS, b, B);
+        }
+
+    private:
+        BigNumber N, g;
+        std::string rI;
+        bool newVS;                                         // v and s are generated and have to be stored
+        BigNumber s, v, b, B;
+};
+
+/// Logon proof SRP6 calculation: session key and verification of the client proof M1
+class LogonProofTask : public AuthCryptoTask
+{
+    public:
+        LogonProofTask(AuthSocket* socket, BigNumber const& N, BigNumber const& g, BigNumber const& s, BigNumber const& v, BigNumber const& b, BigNumber const& B,
+                       BigNumber const& A, std::string const& login, uint8 const* M1)
+            : AuthCryptoTask(socket), N(N), g(g), s(s), v(v), b(b), B(B), A(A), login(login), matched(false)
+        {
+            memcpy(this->M1, M1, 20);
+        }
+
+        int call() override
+        {
+            Sha1Hash sha;
+            sha.UpdateBigNumbers(&A, &B, NULL);
+            sha.Finalize();
+            BigNumber u;
+            u.SetBinary(sha.GetDigest(), 20);
+            BigNumber S = (A * (v.ModExp(u, N))).ModExp(b, N);
+
+            uint8 t[32];
+            uint8 t1[16];
+            uint8 vK[40];
+            memcpy(t, S.AsByteArray(32), 32);
+            for (int i = 0; i < 16; ++i)
+            {
+                t1[i] = t[i * 2];
+            }
+            sha.Initialize();
+            sha.UpdateData(t1, 16);
+            sha.Finalize();
+            for (int i = 0; i < 20; ++i)
+            {
+                vK[i * 2] = sha.GetDigest()[i];
+            }
+            for (int i = 0; i < 16; ++i)
+            {
+                t1[i] = t[i * 2 + 1];
+            }
+            sha.Initialize();
+            sha.UpdateData(t1, 16);
+            sha.Finalize();
+            for (int i = 0; i < 20; ++i)
+            {
+                vK[i * 2 + 1] = sha.GetDigest()[i];
+            }
+            K.SetBinary(vK, 40);
+
+            uint8 hash[20];
+
+            sha.Initialize();
+            sha.UpdateBigNumbers(&N, NULL);
+            sha.Finalize();
+            memcpy(hash, sha.GetDigest(), 20);
+            sha.Initialize();
+            sha.UpdateBigNumbers(&g, NULL);
+            sha.Finalize();
+            for (int i = 0; i < 20; ++i)
+            {
+                hash[i] ^= sha.GetDigest()[i];
+            }
+            BigNumber t3;
+            t3.SetBinary(hash, 20);
+
+            sha.Initialize();
+            sha.UpdateData(login);
+            sha.Finalize();
+            uint8 t4[SHA_DIGEST_LENGTH];
+            memcpy(t4, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+            sha.Initialize();
+            sha.UpdateBigNumbers(&t3, NULL);
+            sha.UpdateData(t4, SHA_DIGEST_LENGTH);
+            sha.UpdateBigNumbers(&s, &A, &B, &K, NULL);
+            sha.Finalize();
+            BigNumber M;
+            M.SetBinary(sha.GetDigest(), 20);
+
+            ///- Check if SRP6 results match (password is correct)
+            matched = !memcmp(M.AsByteArray(), M1, 20);
+            if (matched)
+            {
+                ///- Finish SRP6, the final result for the client
+                proof.UpdateBigNumbers(&A, &M, &K, NULL);
+                proof.Finalize();
+            }
+            return 0;
+        }
+
+        void Finish(AuthSocket& socket) override
+        {
+            socket._FinishLogonProof(matched, K, proof);
+        }
+
+    private:
+        BigNumber N, g, s, v, b, B, A;
+        std::string login;
+        uint8 M1[20];
+
+        bool matched;
+        BigNumber K;
+        Sha1Hash proof;
+};
 
 void AuthSocket::SendProof(Sha1Hash sha)
 {
@@ -372,6 +548,17 @@ bool AuthSocket::_HandleLogonChallenge()
     pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
     pkt << (uint8) 0x00;
 
+    ///- Turn the login away while the crypto workers are behind, the client can retry in a moment
+    if (sAuthCryptoPool->IsSaturated())
+    {
+        sAuthCryptoPool->CountRejected();
+        pkt << (uint8)WOW_FAIL_DB_BUSY;
+        send((char const*)pkt.contents(), pkt.size());
+        return true;
+    }
+
+    bool pending = false;                                   // success answer is sent once the SRP6 calculation is done
+
     ///- Verify that this IP is not in the ip_banned table
     // No SQL injection possible (paste the IP address as passed by the socket)
     std::string address = get_remote_address();
@@ -450,60 +637,6 @@ bool AuthSocket::_HandleLogonChallenge()
 
                     DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
 
-                    // multiply with 2, bytes are stored as hexstring
-                    if (databaseV.size() != s_BYTE_SIZE * 2 || databaseS.size() != s_BYTE_SIZE * 2)
-                    {
-                        _SetVSFields(rI);
-                    }
-                    else
-                    {
-                        s.SetHexStr(databaseS.c_str());
-                        v.SetHexStr(databaseV.c_str());
-                    }
-
-                    b.SetRand(19 * 8);
-                    BigNumber gmod = g.ModExp(b, N);
-                    B = ((v * 3) + gmod) % N;
-
-                    MANGOS_ASSERT(gmod.GetNumBytes() <= 32);
-
-                    BigNumber unk3;
-                    unk3.SetRand(16 * 8);
-
-                    ///- Fill the response packet with the result
-                    pkt << uint8(WOW_SUCCESS);
-
-                    // B may be calculated < 32B so we force minimal length to 32B
-                    pkt.append(B.AsByteArray(32), 32);      // 32 bytes
-                    pkt << uint8(1);
-                    pkt.append(g.AsByteArray(), 1);
-                    pkt << uint8(32);
-                    pkt.append(N.AsByteArray(32), 32);
-                    pkt.append(s.AsByteArray(), s.GetNumBytes());// 32 bytes
-                    pkt.append(unk3.AsByteArray(16), 16);
-                    uint8 securityFlags = 0;
-                    pkt << uint8(securityFlags);            // security flags (0x0...0x04)
-
-                    if (securityFlags & 0x01)               // PIN input
-                    {
-                        pkt << uint32(0);
-                        pkt << uint64(0) << uint64(0);      // 16 bytes hash?
-                    }
-
-                    if (securityFlags & 0x02)               // Matrix input
-                    {
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint64(0);
-                    }
-
-                    if (securityFlags & 0x04)               // Security token input
-                    {
-                        pkt << uint8(1);
-                    }
-
                     uint8 secLevel = (*result)[4].GetUInt8();
                     _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
 
@@ -515,7 +648,8 @@ bool AuthSocket::_HandleLogonChallenge()
 
                     BASIC_LOG("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str(), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
 
-                    _status = STATUS_LOGON_PROOF;
+                    _StartCryptoTask(new LogonChallengeTask(this, N, g, rI, databaseV, databaseS));
+                    pending = true;
                 }
             }
             delete result;
@@ -525,10 +659,80 @@ bool AuthSocket::_HandleLogonChallenge()
             pkt << (uint8) WOW_FAIL_UNKNOWN_ACCOUNT;
         }
     }
-    send((char const*)pkt.contents(), pkt.size());
+
+    if (!pending)
+    {
+        send((char const*)pkt.contents(), pkt.size());
+    }
     return true;
 }
 
+/// Sends the logon challenge answer once B is calculated
+void AuthSocket::_FinishLogonChallenge(BigNumber& newS, BigNumber& newV, bool newVS, BigNumber& newb, BigNumber& newB)
+{
+    s = newS;
+    v = newV;
+    b = newb;
+    B = newB;
+
+    if (newVS)
+    {
+        // No SQL injection (username escaped)
+        const char* v_hex, *s_hex;
+        v_hex = v.AsHexStr();
+        s_hex = s.AsHexStr();
+        LoginDatabase.PExecute("UPDATE `account` SET `v` = '%s', `s` = '%s' WHERE `username` = '%s'", v_hex, s_hex, _safelogin.c_str());
+        OPENSSL_free((void*)v_hex);
+        OPENSSL_free((void*)s_hex);
+    }
+
+    BigNumber unk3;
+    unk3.SetRand(16 * 8);
+
+    ///- Fill the response packet with the result
+    ByteBuffer pkt;
+    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
+    pkt << (uint8) 0x00;
+    pkt << uint8(WOW_SUCCESS);
+
+    // B may be calculated < 32B so we force minimal length to 32B
+    pkt.append(B.AsByteArray(32), 32);                      // 32 bytes
+    pkt << uint8(1);
+    pkt.append(g.AsByteArray(), 1);
+    pkt << uint8(32);
+    pkt.append(N.AsByteArray(32), 32);
+    pkt.append(s.AsByteArray(), s.GetNumBytes());           // 32 bytes
+    pkt.append(unk3.AsByteArray(16), 16);
+    uint8 securityFlags = 0;
+    pkt << uint8(securityFlags);                            // security flags (0x0...0x04)
+
+    if (securityFlags & 0x01)                               // PIN input
+    {
+        pkt << uint32(0);
+        pkt << uint64(0) << uint64(0);                      // 16 bytes hash?
+    }
+
+    if (securityFlags & 0x02)                               // Matrix input
+    {
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint8(0);
+        pkt << uint64(0);
+    }
+
+    if (securityFlags & 0x04)                               // Security token input
+    {
+        pkt << uint8(1);
+    }
+
+    send((char const*)pkt.contents(), pkt.size());
+
+    _status = STATUS_LOGON_PROOF;
+
+    _ResumeAfterCrypto();
+}
+
 /// Logon Proof command handler
 bool AuthSocket::_HandleLogonProof()
 {
@@ -621,74 +825,19 @@ bool AuthSocket::_HandleLogonProof()
         return false;
     }
 
-    Sha1Hash sha;
-    sha.UpdateBigNumbers(&A, &B, NULL);
-    sha.Finalize();
-    BigNumber u;
-    u.SetBinary(sha.GetDigest(), 20);
-    BigNumber S = (A * (v.ModExp(u, N))).ModExp(b, N);
-
-    uint8 t[32];
-    uint8 t1[16];
-    uint8 vK[40];
-    memcpy(t, S.AsByteArray(32), 32);
-    for (int i = 0; i < 16; ++i)
-    {
-        t1[i] = t[i * 2];
-    }
-    sha.Initialize();
-    sha.UpdateData(t1, 16);
-    sha.Finalize();
-    for (int i = 0; i < 20; ++i)
-    {
-        vK[i * 2] = sha.GetDigest()[i];
-    }
-    for (int i = 0; i < 16; ++i)
-    {
-        t1[i] = t[i * 2 + 1];
-    }
-    sha.Initialize();
-    sha.UpdateData(t1, 16);
-    sha.Finalize();
-    for (int i = 0; i < 20; ++i)
-    {
-        vK[i * 2 + 1] = sha.GetDigest()[i];
-    }
-    K.SetBinary(vK, 40);
-
-    uint8 hash[20];
-
-    sha.Initialize();
-    sha.UpdateBigNumbers(&N, NULL);
-    sha.Finalize();
-    memcpy(hash, sha.GetDigest(), 20);
-    sha.Initialize();
-    sha.UpdateBigNumbers(&g, NULL);
-    sha.Finalize();
-    for (int i = 0; i < 20; ++i)
-    {
-        hash[i] ^= sha.GetDigest()[i];
-    }
-    BigNumber t3;
-    t3.SetBinary(hash, 20);
-
-    sha.Initialize();
-    sha.UpdateData(_login);
-    sha.Finalize();
-    uint8 t4[SHA_DIGEST_LENGTH];
-    memcpy(t4, sha.GetDigest(), SHA_DIGEST_LENGTH);
-
-    sha.Initialize();
-    sha.UpdateBigNumbers(&t3, NULL);
-    sha.UpdateData(t4, SHA_DIGEST_LENGTH);
-    sha.UpdateBigNumbers(&s, &A, &B, &K, NULL);
-    sha.Finalize();
-    BigNumber M;
-    M.SetBinary(sha.GetDigest(), 20);
+    ///- The answer is sent when the SRP6 calculation is done
+    _StartCryptoTask(new LogonProofTask(this, N, g, s, v, b, B, A, _login, lp.M1));
+    return true;
+}
 
+/// Sends the logon proof answer once the client proof is verified
+void AuthSocket::_FinishLogonProof(bool matched, BigNumber& newK, Sha1Hash& proof)
+{
     ///- Check if SRP6 results match (password is correct), else send an error
-    if (!memcmp(M.AsByteArray(), lp.M1, 20))
+    if (matched)
     {
+        K = newK;
+
         BASIC_LOG("User '%s' successfully authenticated", _login.c_str());
 
         ///- Update the sessionkey, last_ip, last login time and reset number of failed logins in the account table for this account
@@ -697,12 +846,8 @@ bool AuthSocket::_HandleLogonProof()
         LoginDatabase.PExecute("UPDATE `account` SET `sessionkey` = '%s', `last_ip` = '%s', `last_login` = NOW(), `locale` = '%u', `os` = '%s', `failed_logins` = 0 WHERE `username` = '%s'", K_hex, get_remote_address().c_str(), GetLocaleByName(_localizationName), _os.c_str(), _safelogin.c_str());
         OPENSSL_free((void*)K_hex);
 
-        ///- Finish SRP6 and send the final result to the client
-        sha.Initialize();
-        sha.UpdateBigNumbers(&A, &M, &K, NULL);
-        sha.Finalize();
-
-        SendProof(sha);
+        ///- Send the final SRP6 result to the client
+        SendProof(proof);
 
         ///- Set _status to authenticated
         _status = STATUS_AUTHED;
@@ -760,7 +905,8 @@ bool AuthSocket::_HandleLogonProof()
             }
         }
     }
-    return true;
+
+    _ResumeAfterCrypto();
 }
 
 /// Reconnect Challenge command handler
@@ -38,6 +38,7 @@
 #include "SocketBuffer/BufferedSocket.h"
 
 class ACE_INET_Addr;
+class AuthCryptoTask;
 struct Realm;
 
 /**
@@ -137,11 +138,28 @@ class AuthSocket: public BufferedSocket
         bool _HandleXferAccept();
 
         /**
-         * @brief
+         * @brief Sends the logon challenge answer, called when the SRP6 calculation is done
+         *
+         * @param newS
+         * @param newV
+         * @param newVS true if s and v were generated and have to be stored
+         * @param newb
+         * @param newB
+         */
+        void _FinishLogonChallenge(BigNumber& newS, BigNumber& newV, bool newVS, BigNumber& newb, BigNumber& newB);
+        /**
+         * @brief Sends the logon proof answer, called when the SRP6 calculation is done
          *
-         * @param rI
+         * @param matched true if the password is correct
+         * @param newK
+         * @param proof
          */
-        void _SetVSFields(const std::string& rI);
+        void _FinishLogonProof(bool matched, BigNumber& newK, Sha1Hash& proof);
+        /**
+         * @brief The crypto pool stopped before the result was delivered, the pool frees the task
+         *
+         */
+        void _DropCryptoTask();
 
     private:
         enum eStatus
@@ -171,11 +189,25 @@ class AuthSocket: public BufferedSocket
 
         ACE_HANDLE patch_; /**< TODO */
 
+        AuthCryptoTask* _cryptoTask; /**< SRP6 calculation running for this socket, no more commands are handled until it is done */
+
         /**
          * @brief
          *
          */
         void InitPatch();
+
+        /**
+         * @brief Hands the SRP6 calculation to the crypto workers
+         *
+         * @param task
+         */
+        void _StartCryptoTask(AuthCryptoTask* task);
+        /**
+         * @brief Continues with commands received while the calculation was running
+         *
+         */
+        void _ResumeAfterCrypto();
 };
 #endif
 /// @}
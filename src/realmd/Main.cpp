@@ -34,6 +34,7 @@
 #include "GitRevision.h"
 #include "Log.h"
 #include "Auth/AuthSocket.h"
+#include "Auth/AuthCrypto.h"
 #include "SystemConfig.h"
 #include "revision_data.h"
 #include "Util.h"
@@ -322,6 +323,9 @@ extern int main(int argc, char** argv)
         return 1;
     }
 
+    ///- Start the workers doing the SRP6 calculations
+    sAuthCryptoPool->Start(ACE_Reactor::instance(), sConfig.GetIntDefault("Crypto.Threads", 2), sConfig.GetIntDefault("Crypto.MaxQueued", 256));
+
     ///- Catch termination signals
     HookSignals();
 
@@ -412,6 +416,9 @@ extern int main(int argc, char** argv)
 #endif
     }
 
+    ///- Stop the crypto workers, logins still waiting for them are dropped
+    sAuthCryptoPool->Stop();
+
     ///- Wait for the delay thread to exit
     LoginDatabase.HaltDelayThread();
 
@@ -417,6 +417,12 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
          * @return bool
          */
         bool IsIncludeTime() const { return m_includeTime; }
+        /**
+         * @brief directory all log files are written to, with trailing path separator
+         *
+         * @return std::string
+         */
+        std::string const& GetLogsDir() const { return m_logsDir; }
 
         /**
          * @brief
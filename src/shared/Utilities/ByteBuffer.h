@@ -27,6 +27,7 @@
 
 #include "Common/Common.h"
 #include "Log/Log.h"
+#include "Utilities/ByteBufferAllocator.h"
 #include "Utilities/ByteConverter.h"
 #include "Utilities/Errors.h"
 
@@ -189,6 +190,20 @@ class ByteBuffer
             _bitpos = 8;
         }
 
+        /**
+         * @brief exchange the contents with another buffer without copying them
+         *
+         * @param buf
+         */
+        void swap(ByteBuffer& buf)
+        {
+            std::swap(_rpos, buf._rpos);
+            std::swap(_wpos, buf._wpos);
+            std::swap(_bitpos, buf._bitpos);
+            std::swap(_curbitval, buf._curbitval);
+            _storage.swap(buf._storage);
+        }
+
         template <typename T> ByteBuffer& append(T value)
         {
             FlushBits();
@@ -1168,7 +1183,7 @@ class ByteBuffer
     protected:
         size_t _rpos, _wpos, _bitpos;
         uint8 _curbitval;
-        std::vector<uint8> _storage; /**< TODO */
+        std::vector<uint8, ByteBufferAllocator<uint8> > _storage; /**< recycled through per thread free lists */
 };
 
 template <typename T>
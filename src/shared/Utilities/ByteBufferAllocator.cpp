@@ -0,0 +1,148 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "ByteBufferAllocator.h"
+
+#include <atomic>
+#include <new>
+
+namespace
+{
+    const size_t MIN_SIZE_CLASS_SHIFT = 6;                  // 64 bytes, ByteBuffer::DEFAULT_SIZE
+    const size_t MAX_SIZE_CLASS_SHIFT = 16;                 // 64k, bigger buffers are rare enough for the heap
+    const size_t SIZE_CLASS_COUNT = MAX_SIZE_CLASS_SHIFT - MIN_SIZE_CLASS_SHIFT + 1;
+    const size_t MAX_CACHED_BYTES_PER_CLASS = 256 * 1024;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct ThreadFreeLists
+    {
+        ThreadFreeLists();
+        ~ThreadFreeLists();
+
+        FreeBlock* blocks[SIZE_CLASS_COUNT];
+        size_t count[SIZE_CLASS_COUNT];
+    };
+
+    // set once the free lists of the thread are gone, blocks released later (static packets at exit) go to the heap
+    thread_local bool threadFreeListsDestroyed = false;
+    thread_local ThreadFreeLists threadFreeLists;
+
+    std::atomic<uint64> heapAllocations(0);
+    std::atomic<uint64> pooledAllocations(0);
+
+    ThreadFreeLists::ThreadFreeLists()
+    {
+        for (size_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+        {
+            blocks[i] = NULL;
+            count[i] = 0;
+        }
+    }
+
+    ThreadFreeLists::~ThreadFreeLists()
+    {
+        for (size_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+        {
+            while (FreeBlock* block = blocks[i])
+            {
+                blocks[i] = block->next;
+                ::operator delete(block);
+            }
+        }
+
+        threadFreeListsDestroyed = true;
+    }
+
+    // index of the smallest class holding size bytes, SIZE_CLASS_COUNT if there is none
+    size_t GetSizeClass(size_t size)
+    {
+        size_t sizeClass = 0;
+        while (sizeClass < SIZE_CLASS_COUNT && (size_t(1) << (sizeClass + MIN_SIZE_CLASS_SHIFT)) < size)
+        {
+            ++sizeClass;
+        }
+
+        return sizeClass;
+    }
+}
+
+void* ByteBufferPool::Allocate(size_t size)
+{
+    size_t sizeClass = GetSizeClass(size);
+    if (sizeClass == SIZE_CLASS_COUNT)
+    {
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    if (!threadFreeListsDestroyed)
+    {
+        if (FreeBlock* block = threadFreeLists.blocks[sizeClass])
+        {
+            threadFreeLists.blocks[sizeClass] = block->next;
+            --threadFreeLists.count[sizeClass];
+            pooledAllocations.fetch_add(1, std::memory_order_relaxed);
+            return block;
+        }
+    }
+
+    // always allocate the full class size, so the block can serve any request of its class later
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(size_t(1) << (sizeClass + MIN_SIZE_CLASS_SHIFT));
+}
+
+void ByteBufferPool::Deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    size_t sizeClass = GetSizeClass(size);
+    if (sizeClass == SIZE_CLASS_COUNT || threadFreeListsDestroyed ||
+        threadFreeLists.count[sizeClass] >= (MAX_CACHED_BYTES_PER_CLASS >> (sizeClass + MIN_SIZE_CLASS_SHIFT)))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = threadFreeLists.blocks[sizeClass];
+    threadFreeLists.blocks[sizeClass] = block;
+    ++threadFreeLists.count[sizeClass];
+}
+
+uint64 ByteBufferPool::GetHeapAllocations()
+{
+    return heapAllocations.load(std::memory_order_relaxed);
+}
+
+uint64 ByteBufferPool::GetPooledAllocations()
+{
+    return pooledAllocations.load(std::memory_order_relaxed);
+}
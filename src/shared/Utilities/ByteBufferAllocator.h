@@ -0,0 +1,91 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2023 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_BYTEBUFFERALLOCATOR
+#define MANGOS_H_BYTEBUFFERALLOCATOR
+
+#include "Common/Common.h"
+
+/**
+ * @brief per thread free lists for ByteBuffer storage
+ *
+ * Packets are short lived: they are built, copied into the socket output
+ * buffer and destroyed, so their storage is recycled by power of two size
+ * classes instead of going back to the heap every time. Blocks freed by
+ * another thread than the one which allocated them are simply kept by the
+ * freeing thread. Every thread caches a bounded amount of memory.
+ */
+class ByteBufferPool
+{
+    public:
+        /**
+         * @brief
+         *
+         * @param size
+         * @return void
+         */
+        static void* Allocate(size_t size);
+        /**
+         * @brief size has to be the one passed to Allocate
+         *
+         * @param ptr
+         * @param size
+         */
+        static void Deallocate(void* ptr, size_t size);
+
+        /**
+         * @brief allocations which had to go to the heap, since startup
+         *
+         * @return uint64
+         */
+        static uint64 GetHeapAllocations();
+        /**
+         * @brief allocations served from a free list, since startup
+         *
+         * @return uint64
+         */
+        static uint64 GetPooledAllocations();
+};
+
+/**
+ * @brief std allocator on top of ByteBufferPool
+ *
+ */
+template<class T>
+class ByteBufferAllocator
+{
+    public:
+        typedef T value_type;
+
+        ByteBufferAllocator() {}
+        template<class U> ByteBufferAllocator(ByteBufferAllocator<U> const&) {}
+
+        T* allocate(size_t n) { return static_cast<T*>(ByteBufferPool::Allocate(n * sizeof(T))); }
+        void deallocate(T* ptr, size_t n) { ByteBufferPool::Deallocate(ptr, n * sizeof(T)); }
+
+        template<class U> bool operator==(ByteBufferAllocator<U> const&) const { return true; }
+        template<class U> bool operator!=(ByteBufferAllocator<U> const&) const { return false; }
+};
+
+#endif
@@ -16,7 +16,8 @@
 ## Third param can be an addition filename for storing detailed log
 
 ## Additional Parameters to be forwarded to MoveMapGen, see mmaps/readme for instructions
-PARAMS="--silent"
+## The script runs several generators side by side, so each one builds its tiles on a single thread
+PARAMS="--silent --threads 1"
 
 ## Already a few map extracted, and don't care anymore
 EXCLUDE_MAPS=""
@@ -22,6 +22,8 @@
  * and lore are copyrighted by Blizzard Entertainment, Inc.
  */
 
+#include <thread>
+
 #include <DetourNavMeshBuilder.h>
 #include <DetourCommon.h>
 
@@ -37,21 +39,31 @@ namespace MMAP
 {
     MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
                            bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-                           bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath) :
+                           bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath, uint32 threads) :
         m_terrainBuilder(NULL),
+        m_threads(threads),
         m_debugOutput(debugOutput),
+        m_offMeshFilePath(offMeshFilePath),
         m_skipContinents(skipContinents),
         m_skipJunkMaps(skipJunkMaps),
         m_skipBattlegrounds(skipBattlegrounds),
         m_maxWalkableAngle(maxWalkableAngle),
         m_bigBaseUnit(bigBaseUnit),
-        m_rcContext(NULL),
-        m_offMeshFilePath(offMeshFilePath)
+        m_rcContext(NULL)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid);
 
         m_rcContext = new rcContext(false);
 
+        if (!m_threads)
+        {
+            m_threads = std::thread::hardware_concurrency();
+        }
+        if (!m_threads)
+        {
+            m_threads = 1;
+        }
+
         discoverTiles();
     }
 
@@ -152,14 +164,17 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildAllMaps()
     {
+        // queue the tiles of every map first, so workers never idle at the end of a map
         for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
         {
             uint32 mapID = (*it).first;
             if (!shouldSkipMap(mapID))
             {
-                buildMap(mapID);
+                queueMap(mapID);
             }
         }
+
+        processTileQueue();
     }
 
     /**************************************************************************/
@@ -179,6 +194,15 @@ namespace MMAP
 
     /**************************************************************************/
     void MapBuilder::buildMap(uint32 mapID)
+    {
+        if (queueMap(mapID))
+        {
+            processTileQueue();
+        }
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::queueMap(uint32 mapID)
     {
         printf("Building map %03u:\n", mapID);
 
@@ -201,7 +225,7 @@ namespace MMAP
 
         if (!tiles->size())
         {
-            return;
+            return false;
         }
 
         // build navMesh
@@ -210,11 +234,11 @@ namespace MMAP
         if (!navMesh)
         {
             printf("Failed creating navmesh!              \n");
-            return;
+            return false;
         }
 
-        // now start building mmtiles for each tile
-        printf("We have %u tiles.                          \n", (unsigned int)tiles->size());
+        MapJob* job = new MapJob(mapID, navMesh);
+        TileJobQueue mapTiles;
         for (set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
         {
             uint32 tileX, tileY;
@@ -227,13 +251,88 @@ namespace MMAP
                 continue;
             }
 
-            buildTile(mapID, tileX, tileY, navMesh);
+            TileJob tile = { job, tileX, tileY };
+            mapTiles.push_back(tile);
         }
 
-        dtFreeNavMesh(navMesh);
+        printf("We have %u tiles.                          \n", (unsigned int)mapTiles.size());
 
-        printf("Complete!                               \n\n");
+        if (mapTiles.empty())
+        {
+            dtFreeNavMesh(navMesh);
+            delete job;
+            printf("Map %03u complete!                      \n\n", mapID);
+            return false;
+        }
+
+        job->pendingTiles = uint32(mapTiles.size());
+
+        std::lock_guard<std::mutex> guard(m_tileQueueLock);
+        m_tileQueue.insert(m_tileQueue.end(), mapTiles.begin(), mapTiles.end());
+        return true;
     }
+
+    /**************************************************************************/
+    void MapBuilder::processTileQueue()
+    {
+        uint32 threads = m_threads;
+        if (threads > m_tileQueue.size())
+        {
+            threads = uint32(m_tileQueue.size());
+        }
+
+        printf("Building %u tiles using %u threads\n", (unsigned int)m_tileQueue.size(), threads);
+
+        vector<std::thread> workers;
+        workers.reserve(threads);
+        for (uint32 i = 0; i < threads; ++i)
+        {
+            workers.push_back(std::thread(&MapBuilder::tileWorker, this));
+        }
+
+        for (vector<std::thread>::iterator itr = workers.begin(); itr != workers.end(); ++itr)
+        {
+            itr->join();
+        }
+    }
+
+    /**************************************************************************/
+    void MapBuilder::tileWorker()
+    {
+        for (;;)
+        {
+            TileJob tile;
+            {
+                std::lock_guard<std::mutex> guard(m_tileQueueLock);
+                if (m_tileQueue.empty())
+                {
+                    return;
+                }
+
+                tile = m_tileQueue.front();
+                m_tileQueue.pop_front();
+            }
+
+            buildTile(tile.map->mapID, tile.tileX, tile.tileY, tile.map->navMesh);
+            finishTile(tile.map);
+        }
+    }
+
+    /**************************************************************************/
+    void MapBuilder::finishTile(MapJob* job)
+    {
+        // last tile of the map - nobody else references the navmesh anymore
+        if (--job->pendingTiles)
+        {
+            return;
+        }
+
+        printf("Map %03u complete!                      \n", job->mapID);
+
+        dtFreeNavMesh(job->navMesh);
+        delete job;
+    }
+
     /**************************************************************************/
     void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
@@ -734,10 +833,19 @@ namespace MMAP
                 continue;
             }
 
+            // the navmesh is shared by all workers building this map, and the tile is only
+            // added to validate it, so keep ownership of navData and release it ourselves
             dtTileRef tileRef = 0;
-            // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
-            // is removed via removeTile()
-            dtStatus dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
+            dtStatus dtResult;
+            {
+                std::lock_guard<std::mutex> guard(m_navMeshLock);
+                dtResult = navMesh->addTile(navData, navDataSize, 0, 0, &tileRef);
+                if (tileRef)
+                {
+                    navMesh->removeTile(tileRef, NULL, NULL);
+                }
+            }
+
             if (!tileRef || dtStatusFailed(dtResult))
             {
                 printf(" Failed adding tile %s to navmesh !           \n", tileString);
@@ -753,7 +861,6 @@ namespace MMAP
                 char message[1024];
                 sprintf(message, "Failed to open %s for writing!\n", fileName);
                 perror(message);
-                navMesh->removeTile(tileRef, NULL, NULL);
                 continue;
             }
 
@@ -766,12 +873,11 @@ namespace MMAP
             // write data
             fwrite(navData, sizeof(unsigned char), navDataSize, file);
             fclose(file);
-
-            // now that tile is written to disk, we can unload it
-            navMesh->removeTile(tileRef, NULL, NULL);
         }
         while (0);
 
+        dtFree(navData);
+
         if (m_debugOutput)
         {
             // restore padding so that the debug visualization is correct
@@ -28,6 +28,9 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
 
 #include <Recast.h>
 #include <DetourNavMesh.h>
@@ -50,6 +53,32 @@ namespace MMAP
      *
      */
     typedef map<uint32, set<uint32>*> TileList;
+
+    /**
+     * @brief per map state shared by all workers building tiles of that map
+     *
+     */
+    struct MapJob
+    {
+        MapJob(uint32 id, dtNavMesh* mesh) : mapID(id), navMesh(mesh), pendingTiles(0) {}
+
+        uint32 mapID; /**< TODO */
+        dtNavMesh* navMesh; /**< freed by the worker finishing the last tile */
+        std::atomic<uint32> pendingTiles; /**< tiles not yet built */
+    };
+
+    /**
+     * @brief single unit of work for the tile worker pool
+     *
+     */
+    struct TileJob
+    {
+        MapJob* map; /**< TODO */
+        uint32 tileX; /**< TODO */
+        uint32 tileY; /**< TODO */
+    };
+
+    typedef std::deque<TileJob> TileJobQueue;
     /**
      * @brief
      *
@@ -98,6 +127,7 @@ namespace MMAP
              * @param debugOutput
              * @param bigBaseUnit
              * @param offMeshFilePath
+             * @param threads number of workers building tiles, 0 for one per hardware thread
              */
             MapBuilder(float maxWalkableAngle   = 60.f,
                        bool skipLiquid          = false,
@@ -106,7 +136,8 @@ namespace MMAP
                        bool skipBattlegrounds   = false,
                        bool debugOutput         = false,
                        bool bigBaseUnit         = false,
-                       const char* offMeshFilePath = NULL);
+                       const char* offMeshFilePath = NULL,
+                       uint32 threads           = 0);
 
             /**
              * @brief
@@ -160,6 +191,33 @@ namespace MMAP
              */
             set<uint32>* getTileList(uint32 mapID);
 
+            /**
+             * @brief creates the navmesh of a map and queues all its tiles for the worker pool
+             *
+             * @param mapID
+             * @return bool false if there was nothing to queue
+             */
+            bool queueMap(uint32 mapID);
+
+            /**
+             * @brief runs the worker pool until every queued tile is built
+             *
+             */
+            void processTileQueue();
+
+            /**
+             * @brief worker loop, pops tiles from the queue until it is empty
+             *
+             */
+            void tileWorker();
+
+            /**
+             * @brief
+             *
+             * @param job
+             */
+            void finishTile(MapJob* job);
+
             /**
              * @brief
              *
@@ -224,9 +282,14 @@ namespace MMAP
              */
             bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY);
 
-            TerrainBuilder* m_terrainBuilder; /**< TODO */
+            TerrainBuilder* m_terrainBuilder; /**< shared read-only by all workers */
             TileList m_tiles; /**< TODO */
 
+            uint32 m_threads; /**< number of tile workers */
+            TileJobQueue m_tileQueue; /**< tiles waiting for a worker, from any number of maps */
+            std::mutex m_tileQueueLock; /**< guards m_tileQueue */
+            std::mutex m_navMeshLock; /**< dtNavMesh::addTile/removeTile are not thread safe */
+
             bool m_debugOutput; /**< TODO */
 
             const char* m_offMeshFilePath; /**< TODO */
@@ -237,7 +300,7 @@ namespace MMAP
             float m_maxWalkableAngle; /**< TODO */
             bool m_bigBaseUnit; /**< TODO */
 
-            rcContext* m_rcContext; /**< build performance - not really used for now */
+            rcContext* m_rcContext; /**< build performance - not really used for now, stateless so shared by workers */
     };
 }
 